@@ -8,13 +8,16 @@ namespace digbuild::platform::desktop::vulkan
 		std::shared_ptr<VulkanContext> context,
 		vk::UniqueBuffer buffer,
 		vma::Allocation memoryAllocation,
-		const uint32_t size
+		const uint32_t size,
+		void* mappedMemory,
+		const bool direct
 	) :
 		m_context(std::move(context)),
 		m_buffer(std::move(buffer)),
 		m_memoryAllocation(memoryAllocation),
-		m_size(size)//,
-		// m_mappedMemory(false)
+		m_size(size),
+		m_mappedMemory(mappedMemory),
+		m_direct(direct)
 	{
 	}
 
@@ -13,7 +13,9 @@ namespace digbuild::platform::desktop::vulkan
 			std::shared_ptr<VulkanContext> context,
 			vk::UniqueBuffer buffer,
 			vma::Allocation memoryAllocation,
-			uint32_t size
+			uint32_t size,
+			void* mappedMemory = nullptr,
+			bool direct = false
 		);
 		~VulkanBuffer();
 		VulkanBuffer(const VulkanBuffer& other) = delete;
@@ -29,6 +31,15 @@ namespace digbuild::platform::desktop::vulkan
 		{
 			return *m_buffer;
 		}
+		[[nodiscard]] uint8_t* mappedMemory() const
+		{
+			return static_cast<uint8_t*>(m_mappedMemory);
+		}
+		// Whether the buffer lives in device-local memory that is mapped for the host to write to
+		[[nodiscard]] bool isDirect() const
+		{
+			return m_direct;
+		}
 
 		// [[nodiscard]] void* mapMemory();
 		// void unmapMemory();
@@ -38,6 +49,8 @@ namespace digbuild::platform::desktop::vulkan
 		vk::UniqueBuffer m_buffer;
 		vma::Allocation m_memoryAllocation;
 		uint32_t m_size;
+		void* m_mappedMemory;
+		bool m_direct;
 		// bool m_mappedMemory;
 	};
 }
@@ -0,0 +1,54 @@
+﻿#include "vk_buffer_capacity.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace digbuild::platform::desktop::vulkan::util
+{
+	BufferCapacity::BufferCapacity(const render::BufferCapacityPolicy policy)
+	{
+		setPolicy(policy);
+	}
+
+	void BufferCapacity::setPolicy(const render::BufferCapacityPolicy policy)
+	{
+		if (policy.growthFactor < 1.0f)
+			throw std::runtime_error("Growth factor must be at least 1.");
+		if (policy.shrinkThreshold < 0.0f || policy.shrinkThreshold >= 1.0f)
+			throw std::runtime_error("Shrink threshold must be between 0 and 1.");
+
+		m_policy = policy;
+		m_framesBelowThreshold = 0;
+	}
+
+	uint32_t BufferCapacity::fit(const uint32_t capacity, const uint32_t size) const
+	{
+		const auto grown = [&](const uint32_t base)
+		{
+			return static_cast<uint32_t>(std::ceil(static_cast<double>(base) * m_policy.growthFactor));
+		};
+
+		if (capacity < size)
+			return std::max(size, grown(capacity));
+
+		// Shrink to leave the same headroom a grown buffer would have
+		if (m_policy.shrinkDelay > 0 && m_framesBelowThreshold >= m_policy.shrinkDelay)
+			return std::min(capacity, std::max(size, grown(size)));
+
+		return capacity;
+	}
+
+	void BufferCapacity::tick(const uint32_t capacity, const uint32_t used)
+	{
+		if (static_cast<double>(used) < static_cast<double>(capacity) * m_policy.shrinkThreshold)
+			m_framesBelowThreshold++;
+		else
+			m_framesBelowThreshold = 0;
+	}
+
+	void BufferCapacity::reallocated()
+	{
+		m_reallocations++;
+	}
+}
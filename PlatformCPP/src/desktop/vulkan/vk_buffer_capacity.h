@@ -0,0 +1,34 @@
+﻿#pragma once
+#include <cstdint>
+
+#include "../../render/buffer_capacity.h"
+
+namespace digbuild::platform::desktop::vulkan::util
+{
+	// Decides when and to what capacity a buffer should be reallocated, growing geometrically
+	// and only shrinking once usage has stayed low for a while
+	class BufferCapacity final
+	{
+	public:
+		explicit BufferCapacity(render::BufferCapacityPolicy policy = {});
+
+		void setPolicy(render::BufferCapacityPolicy policy);
+
+		// Returns the capacity to reallocate to so that the size fits, or the current capacity if it can stay
+		[[nodiscard]] uint32_t fit(uint32_t capacity, uint32_t size) const;
+		// Records the usage of the current frame. Must be called once per frame.
+		void tick(uint32_t capacity, uint32_t used);
+		// Records a reallocation to the capacity returned by fit
+		void reallocated();
+
+		[[nodiscard]] uint32_t getReallocations() const
+		{
+			return m_reallocations;
+		}
+
+	private:
+		render::BufferCapacityPolicy m_policy;
+		uint32_t m_framesBelowThreshold = 0;
+		uint32_t m_reallocations = 0;
+	};
+}
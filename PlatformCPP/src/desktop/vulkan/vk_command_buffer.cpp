@@ -1,36 +1,70 @@
 #include "vk_command_buffer.h"
 
+#include <algorithm>
+
 #include "vk_framebuffer_format.h"
+#include "vk_index_buffer.h"
+#include "vk_indirect_draw_buffer.h"
+#include "vk_range_allocator.h"
 #include "vk_render_pipeline.h"
 #include "vk_texture_binding.h"
+#include "vk_transient_vertex_allocator.h"
 #include "vk_uniform_binding.h"
 #include "vk_vertex_buffer.h"
 
 namespace digbuild::platform::desktop::vulkan
 {
-	void CBCmdBegin::record(
-		vk::CommandBuffer& cmd,
-		std::vector<std::shared_ptr<render::Resource>>& resources
-	)
+	// Clamps a draw range to the contents of the buffer, which may have shrunk since it was requested
+	uint32_t clampDrawCount(const uint32_t first, const uint32_t count, const uint32_t size)
 	{
-		vk::CommandBufferInheritanceInfo inheritanceInfo{ m_format->getPass() };
-		cmd.begin({ vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eSimultaneousUse, &inheritanceInfo });
+		if (first >= size)
+			return 0;
+		return std::min(count, size - first);
 	}
 
-	void CBCmdEnd::record(
-		vk::CommandBuffer& cmd,
-		std::vector<std::shared_ptr<render::Resource>>& resources
-	)
+	uint32_t clampInstanceCount(const uint32_t first, const uint32_t count, VertexBuffer* instanceBuffer)
 	{
-		cmd.end();
+		if (instanceBuffer)
+			return clampDrawCount(first, count, instanceBuffer->size());
+		return count == render::DRAW_REMAINING ? 1 : count;
 	}
 
-	void CBCmdSetViewportScissor::record(
-		vk::CommandBuffer& cmd,
-		std::vector<std::shared_ptr<render::Resource>>& resources
-	)
+	// Keeps every record aligned for the pointers and handles it contains
+	constexpr uint32_t COMMAND_ALIGNMENT = 8;
+
+	bool isStatic(const VertexBuffer* buffer)
 	{
-		auto& fb = m_renderTarget->getFramebuffer();
+		return buffer && buffer->getKind() == VertexBufferKind::STATIC;
+	}
+
+	void bindVertexBuffers(vk::CommandBuffer& cmd, const vk::Buffer& vertexBuffer, const uint32_t vertexOffset, VertexBuffer* instanceBuffer)
+	{
+		if (instanceBuffer)
+		{
+			cmd.bindVertexBuffers(
+				0,
+				{ vertexBuffer, instanceBuffer->get() },
+				{ vertexOffset, instanceBuffer->offset() }
+			);
+		}
+		else
+		{
+			cmd.bindVertexBuffers(
+				0,
+				{ vertexBuffer },
+				{ vertexOffset }
+			);
+		}
+	}
+
+	void bindVertexBuffers(vk::CommandBuffer& cmd, VertexBuffer* vertexBuffer, VertexBuffer* instanceBuffer)
+	{
+		bindVertexBuffers(cmd, vertexBuffer->get(), vertexBuffer->offset(), instanceBuffer);
+	}
+
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdSetViewportScissor& command)
+	{
+		auto& fb = command.renderTarget->getFramebuffer();
 		
 		cmd.setViewport(0, vk::Viewport{
 			0, 0,
@@ -43,109 +77,136 @@ namespace digbuild::platform::desktop::vulkan
 		});
 	}
 
-	void CBCmdSetViewport::record(
-		vk::CommandBuffer& cmd,
-		std::vector<std::shared_ptr<render::Resource>>& resources
-	)
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdSetViewport& command)
 	{
 		cmd.setViewport(0, vk::Viewport{
-			static_cast<float>(m_extents.x), static_cast<float>(m_extents.y),
-			static_cast<float>(m_extents.width), static_cast<float>(m_extents.height),
+			static_cast<float>(command.extents.x), static_cast<float>(command.extents.y),
+			static_cast<float>(command.extents.width), static_cast<float>(command.extents.height),
 			0.0f, 1.0f
 		});
 	}
 
-	void CBCmdSetScissor::record(
-		vk::CommandBuffer& cmd,
-		std::vector<std::shared_ptr<render::Resource>>& resources
-	)
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdSetScissor& command)
 	{
 		cmd.setScissor(0, vk::Rect2D{
-			{ static_cast<int32_t>(m_extents.x), static_cast<int32_t>(m_extents.y) },
-			{ m_extents.width, m_extents.height }
+			{ static_cast<int32_t>(command.extents.x), static_cast<int32_t>(command.extents.y) },
+			{ command.extents.width, command.extents.height }
 		});
 	}
 
-	void CBCmdBindUniform::record(
-		vk::CommandBuffer& cmd,
-		std::vector<std::shared_ptr<render::Resource>>& resources
-	)
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdBindUniform& command)
 	{
-		auto pipeline = std::static_pointer_cast<RenderPipeline>(m_pipeline);
-		auto ub = std::static_pointer_cast<UniformBinding>(m_uniformBinding);
-		
+		auto* ub = command.uniformBinding;
 		cmd.bindDescriptorSets(
 			vk::PipelineBindPoint::eGraphics,
-			pipeline->getLayout(),
-			pipeline->getLayoutOffset(ub->getShader()) + ub->getBinding(),
+			command.layout,
+			command.set,
 			{ ub->get() },
-			{ m_binding * ub->getBindingSize() }
+			{ command.binding * ub->getBindingSize() }
 		);
-
-		resources.push_back(pipeline);
-		resources.push_back(ub);
 	}
 
-	void CBCmdBindTexture::record(
-		vk::CommandBuffer& cmd,
-		std::vector<std::shared_ptr<render::Resource>>& resources
-	)
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdBindTexture& command)
 	{
-		auto pipeline = std::static_pointer_cast<RenderPipeline>(m_pipeline);
-		auto tb = std::static_pointer_cast<TextureBinding>(m_binding);
-
 		cmd.bindDescriptorSets(
 			vk::PipelineBindPoint::eGraphics,
-			pipeline->getLayout(),
-			pipeline->getLayoutOffset(tb->getShader()) + tb->getBinding(),
-			{ tb->get() },
+			command.layout,
+			command.set,
+			{ command.binding->get() },
 			{}
 		);
+	}
 
-		resources.push_back(pipeline);
-		resources.push_back(tb);
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdPushConstants& command)
+	{
+		const auto* data = reinterpret_cast<const uint8_t*>(&command) + sizeof(CBCmdPushConstants);
+		cmd.pushConstants(command.layout, command.stages, command.offset, command.size, data);
 	}
 
-	void CBCmdDraw::record(
-		vk::CommandBuffer& cmd,
-		std::vector<std::shared_ptr<render::Resource>>& resources
-	)
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdDraw& command)
 	{
-		auto p = std::static_pointer_cast<RenderPipeline>(m_pipeline);
-		cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, p->get());
+		cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, command.pipeline);
+		bindVertexBuffers(cmd, command.vertexBuffer, command.instanceBuffer);
+		cmd.draw(
+			clampDrawCount(command.range.firstVertex, command.range.vertexCount, command.vertexBuffer->size()),
+			clampInstanceCount(command.range.firstInstance, command.range.instanceCount, command.instanceBuffer),
+			command.range.firstVertex,
+			command.range.firstInstance
+		);
+	}
 
-		auto vb = std::static_pointer_cast<VertexBuffer>(m_vertexBuffer);
-		if (m_instanceBuffer)
-		{
-			auto ib = std::static_pointer_cast<VertexBuffer>(m_instanceBuffer);
-			cmd.bindVertexBuffers(
-				0,
-				{ vb->get(), ib->get() },
-				{ 0, 0 }
-			);
-			cmd.draw(vb->size(), ib->size(), 0, 0);
-		}
-		else
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdDrawIndexed& command)
+	{
+		cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, command.pipeline);
+
+		auto* ixb = command.indexBuffer;
+		cmd.bindIndexBuffer(ixb->get(), ixb->offset(), ixb->getVkIndexType());
+		bindVertexBuffers(cmd, command.vertexBuffer, command.instanceBuffer);
+		cmd.drawIndexed(
+			clampDrawCount(command.range.firstIndex, command.range.indexCount, ixb->size()),
+			clampInstanceCount(command.range.firstInstance, command.range.instanceCount, command.instanceBuffer),
+			command.range.firstIndex,
+			command.range.vertexOffset,
+			command.range.firstInstance
+		);
+	}
+
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdDrawIndirect& command)
+	{
+		cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, command.pipeline);
+		bindVertexBuffers(cmd, command.vertexBuffer, command.instanceBuffer);
+		if (command.indexBuffer)
 		{
-			cmd.bindVertexBuffers(
-				0,
-				{ vb->get() },
-				{ 0 }
-			);
-			cmd.draw(vb->size(), 1, 0, 0);
+			auto* ixb = command.indexBuffer;
+			cmd.bindIndexBuffer(ixb->get(), ixb->offset(), ixb->getVkIndexType());
 		}
-		
-		resources.push_back(m_pipeline);
-		resources.push_back(m_vertexBuffer);
-		if (m_instanceBuffer)
-			resources.push_back(m_instanceBuffer);
+
+		command.indirectBuffer->record(cmd);
+	}
+
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdDrawTransient& command)
+	{
+		cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, command.pipeline);
+		bindVertexBuffers(cmd, command.vertices.buffer, command.vertices.offset, command.instanceBuffer);
+		cmd.draw(
+			clampDrawCount(command.range.firstVertex, command.range.vertexCount, command.vertices.vertexCount),
+			clampInstanceCount(command.range.firstInstance, command.range.instanceCount, command.instanceBuffer),
+			command.range.firstVertex,
+			command.range.firstInstance
+		);
+	}
+
+	void recordCommand(vk::CommandBuffer& cmd, const CBCmdDrawIndexedTransient& command)
+	{
+		cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, command.pipeline);
+
+		auto* ixb = command.indexBuffer;
+		cmd.bindIndexBuffer(ixb->get(), ixb->offset(), ixb->getVkIndexType());
+		bindVertexBuffers(cmd, command.vertices.buffer, command.vertices.offset, command.instanceBuffer);
+		cmd.drawIndexed(
+			clampDrawCount(command.range.firstIndex, command.range.indexCount, ixb->size()),
+			clampInstanceCount(command.range.firstInstance, command.range.instanceCount, command.instanceBuffer),
+			command.range.firstIndex,
+			command.range.vertexOffset,
+			command.range.firstInstance
+		);
+	}
+
+	template<typename T>
+	const T& read(const uint8_t* record)
+	{
+		return *reinterpret_cast<const T*>(record + sizeof(CBCmdHeader));
 	}
 
 	CommandBuffer::CommandBuffer(
 		std::shared_ptr<VulkanContext> context, 
+		std::shared_ptr<GeometryArena> geometryArena,
+		std::shared_ptr<TransientVertexAllocator> transientVertexAllocator,
 		const uint32_t stages
 	) :
-		m_context(std::move(context))
+		m_context(std::move(context)),
+		m_geometryArena(std::move(geometryArena)),
+		m_transientVertexAllocator(std::move(transientVertexAllocator))
 	{
 		m_commandBuffers = m_context->createCommandBuffers(stages, vk::CommandBufferLevel::eSecondary);
 		m_resources.reserve(stages);
@@ -157,19 +218,48 @@ namespace digbuild::platform::desktop::vulkan
 	{
 		const auto writeIndex = (m_readIndex + 1) % static_cast<uint32_t>(m_commandBuffers.size());
 
-		if (m_leftoverWrites == 0)
+		// The transient vertices of the last commit have been recycled, so nothing is drawn until the next one
+		if (m_recordedTransientVertices)
+		{
+			m_commands.clear();
+			m_retained.clear();
+			m_retainedSet.clear();
+			m_indirectBuffers.clear();
+			m_usesTransientVertices = false;
+			m_recordedTransientVertices = false;
+			m_usesGeometryArena = false;
+			m_leftoverWrites = static_cast<uint32_t>(m_commandBuffers.size());
+		}
+
+		const auto generation = m_geometryArena->getGeneration();
+		if (m_usesGeometryArena && m_geometryGeneration != generation)
+		{
+			m_geometryGeneration = generation;
+			m_leftoverWrites = static_cast<uint32_t>(m_commandBuffers.size());
+		}
+
+		const auto indirectGeneration = getIndirectGeneration();
+		if (m_indirectGeneration != indirectGeneration)
+		{
+			m_indirectGeneration = indirectGeneration;
+			m_leftoverWrites = static_cast<uint32_t>(m_commandBuffers.size());
+		}
+
+		if (m_leftoverWrites == 0 || !m_format)
 		{
 			m_readIndex = writeIndex;
 			return;
 		}
 
 		auto& cmd = *m_commandBuffers[writeIndex];
-		auto& resources = m_resources[writeIndex];
-		resources.clear();
+		m_resources[writeIndex].assign(m_retained.begin(), m_retained.end());
 
-		for (auto& cbCmd : m_commandQueue)
-			cbCmd->record(cmd, resources);
+		vk::CommandBufferInheritanceInfo inheritanceInfo{ m_format->getPass() };
+		cmd.begin({ vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eSimultaneousUse, &inheritanceInfo });
+		replay(cmd);
+		cmd.end();
 
+		m_recordedTransientVertices = m_usesTransientVertices;
 		m_leftoverWrites--;
 		m_readIndex = writeIndex;
 	}
@@ -189,60 +279,275 @@ namespace digbuild::platform::desktop::vulkan
 
 	void CommandBuffer::beginRecording(const std::shared_ptr<render::FramebufferFormat>& format)
 	{
-		m_commandQueue.clear();
-		m_commandQueue.push_back(std::make_unique<CBCmdBegin>(std::static_pointer_cast<FramebufferFormat>(format)));
+		m_commands.clear();
+		m_retained.clear();
+		m_retainedSet.clear();
+		m_indirectBuffers.clear();
+		m_format = std::static_pointer_cast<FramebufferFormat>(format);
+		m_usesGeometryArena = false;
+		m_usesTransientVertices = false;
+		m_recordedTransientVertices = false;
 	}
 
-	void CommandBuffer::setViewportAndScissor(std::shared_ptr<render::IRenderTarget> renderTarget)
+	bool CommandBuffer::isRetained(const Resource* resource) const
 	{
-		m_commandQueue.push_back(std::make_unique<CBCmdSetViewportScissor>(renderTarget));
+		return m_retainedSet.find(resource) != m_retainedSet.end();
+	}
+
+	void CommandBuffer::retain(std::shared_ptr<Resource> resource)
+	{
+		if (m_retainedSet.insert(resource.get()).second)
+			m_retained.push_back(std::move(resource));
+	}
+
+	void CommandBuffer::setViewportAndScissor(render::IRenderTarget* renderTarget)
+	{
+		push(CBCmdType::SET_VIEWPORT_SCISSOR, CBCmdSetViewportScissor{ renderTarget });
 	}
 
 	void CommandBuffer::setViewport(const platform::util::Extents2D extents)
 	{
-		m_commandQueue.push_back(std::make_unique<CBCmdSetViewport>(extents));
+		push(CBCmdType::SET_VIEWPORT, CBCmdSetViewport{ extents });
 	}
 
 	void CommandBuffer::setScissor(const platform::util::Extents2D extents)
 	{
-		m_commandQueue.push_back(std::make_unique<CBCmdSetScissor>(extents));
+		push(CBCmdType::SET_SCISSOR, CBCmdSetScissor{ extents });
 	}
 
 	void CommandBuffer::bindUniform(
-		std::shared_ptr<render::RenderPipeline> pipeline,
-			std::shared_ptr<render::UniformBinding> uniformBinding,
-		uint32_t binding
+		render::RenderPipeline* pipeline,
+		render::UniformBinding* uniformBinding,
+		const uint32_t binding
 	)
 	{
-		m_commandQueue.push_back(std::make_unique<CBCmdBindUniform>(pipeline, uniformBinding, binding));
+		auto* p = static_cast<RenderPipeline*>(pipeline);
+		auto* ub = static_cast<UniformBinding*>(uniformBinding);
+		push(CBCmdType::BIND_UNIFORM, CBCmdBindUniform{
+			p->getLayout(),
+			p->getLayoutOffset(ub->getShader()) + ub->getBinding(),
+			binding,
+			ub
+		});
 	}
 
 	void CommandBuffer::bindTexture(
-		std::shared_ptr<render::RenderPipeline> pipeline,
-		std::shared_ptr<render::TextureBinding> binding
+		render::RenderPipeline* pipeline,
+		render::TextureBinding* binding
+	)
+	{
+		auto* p = static_cast<RenderPipeline*>(pipeline);
+		auto* tb = static_cast<TextureBinding*>(binding);
+		push(CBCmdType::BIND_TEXTURE, CBCmdBindTexture{
+			p->getLayout(),
+			p->getLayoutOffset(tb->getShader()) + tb->getBinding(),
+			tb
+		});
+	}
+
+	void CommandBuffer::pushConstants(
+		render::RenderPipeline* pipeline,
+		const uint32_t offset,
+		const uint8_t* data,
+		const uint32_t size
 	)
 	{
-		m_commandQueue.push_back(std::make_unique<CBCmdBindTexture>(pipeline, binding));
+		if (offset + size > render::MAX_PUSH_CONSTANTS_SIZE)
+			throw std::runtime_error("Push constant data exceeds the maximum push constant size.");
+
+		auto* p = static_cast<RenderPipeline*>(pipeline);
+		const CBCmdPushConstants command{ p->getLayout(), p->getPushConstantStages(offset, size), offset, size };
+		auto* record = append(CBCmdType::PUSH_CONSTANTS, sizeof(CBCmdPushConstants) + size);
+		memcpy(record, &command, sizeof(CBCmdPushConstants));
+		memcpy(record + sizeof(CBCmdPushConstants), data, size);
 	}
 
 	void CommandBuffer::draw(
-		const std::shared_ptr<render::RenderPipeline> pipeline,
-		const std::shared_ptr<render::VertexBuffer> vertexBuffer,
-		const std::shared_ptr<render::VertexBuffer> instanceBuffer
+		render::RenderPipeline* pipeline,
+		render::VertexBuffer* vertexBuffer,
+		render::VertexBuffer* instanceBuffer,
+		const render::DrawRange range
+	)
+	{
+		auto* vb = static_cast<VertexBuffer*>(vertexBuffer);
+		auto* instances = static_cast<VertexBuffer*>(instanceBuffer);
+		m_usesGeometryArena |= isStatic(vb) || isStatic(instances);
+		push(CBCmdType::DRAW, CBCmdDraw{
+			static_cast<RenderPipeline*>(pipeline)->get(),
+			vb,
+			instances,
+			range
+		});
+	}
+
+	void CommandBuffer::drawIndexed(
+		render::RenderPipeline* pipeline,
+		render::VertexBuffer* vertexBuffer,
+		render::IndexBuffer* indexBuffer,
+		render::VertexBuffer* instanceBuffer,
+		const render::DrawIndexedRange range
+	)
+	{
+		auto* vb = static_cast<VertexBuffer*>(vertexBuffer);
+		auto* instances = static_cast<VertexBuffer*>(instanceBuffer);
+		m_usesGeometryArena |=
+			isStatic(vb) ||
+			static_cast<IndexBuffer*>(indexBuffer)->isStatic() ||
+			isStatic(instances);
+		push(CBCmdType::DRAW_INDEXED, CBCmdDrawIndexed{
+			static_cast<RenderPipeline*>(pipeline)->get(),
+			vb,
+			static_cast<IndexBuffer*>(indexBuffer),
+			instances,
+			range
+		});
+	}
+
+	void CommandBuffer::drawTransient(
+		render::RenderPipeline* pipeline,
+		const render::TransientVertexRange& vertices,
+		render::VertexBuffer* instanceBuffer,
+		const render::DrawRange range
+	)
+	{
+		auto* instances = static_cast<VertexBuffer*>(instanceBuffer);
+		m_usesGeometryArena |= isStatic(instances);
+		m_usesTransientVertices = true;
+		push(CBCmdType::DRAW_TRANSIENT, CBCmdDrawTransient{
+			static_cast<RenderPipeline*>(pipeline)->get(),
+			m_transientVertexAllocator->resolve(vertices),
+			instances,
+			range
+		});
+	}
+
+	void CommandBuffer::drawIndexedTransient(
+		render::RenderPipeline* pipeline,
+		const render::TransientVertexRange& vertices,
+		render::IndexBuffer* indexBuffer,
+		render::VertexBuffer* instanceBuffer,
+		const render::DrawIndexedRange range
+	)
+	{
+		auto* instances = static_cast<VertexBuffer*>(instanceBuffer);
+		m_usesGeometryArena |=
+			static_cast<IndexBuffer*>(indexBuffer)->isStatic() ||
+			isStatic(instances);
+		m_usesTransientVertices = true;
+		push(CBCmdType::DRAW_INDEXED_TRANSIENT, CBCmdDrawIndexedTransient{
+			static_cast<RenderPipeline*>(pipeline)->get(),
+			m_transientVertexAllocator->resolve(vertices),
+			static_cast<IndexBuffer*>(indexBuffer),
+			instances,
+			range
+		});
+	}
+
+	void CommandBuffer::drawIndirect(
+		render::RenderPipeline* pipeline,
+		render::VertexBuffer* vertexBuffer,
+		render::IndexBuffer* indexBuffer,
+		render::VertexBuffer* instanceBuffer,
+		render::IndirectDrawBuffer* indirectBuffer
 	)
 	{
-		m_commandQueue.push_back(std::make_unique<CBCmdDraw>(pipeline, vertexBuffer, instanceBuffer));
+		if (indirectBuffer->isIndexed() != (indexBuffer != nullptr))
+			throw std::runtime_error("Indexed indirect draws require an index buffer, and only they accept one.");
+
+		auto* vb = static_cast<VertexBuffer*>(vertexBuffer);
+		auto* instances = static_cast<VertexBuffer*>(instanceBuffer);
+		m_usesGeometryArena |=
+			isStatic(vb) ||
+			(indexBuffer && static_cast<IndexBuffer*>(indexBuffer)->isStatic()) ||
+			isStatic(instances);
+		push(CBCmdType::DRAW_INDIRECT, CBCmdDrawIndirect{
+			static_cast<RenderPipeline*>(pipeline)->get(),
+			vb,
+			static_cast<IndexBuffer*>(indexBuffer),
+			instances,
+			static_cast<IndirectDrawBuffer*>(indirectBuffer)
+		});
+		m_indirectBuffers.push_back(static_cast<IndirectDrawBuffer*>(indirectBuffer));
 	}
 
 	void CommandBuffer::finishRecording()
 	{
-		m_commandQueue.push_back(std::make_unique<CBCmdEnd>());
-		
-		m_leftoverWrites = static_cast<uint32_t>(m_commandBuffers.size());
+		// Transient vertices only exist for the current frame, so later stages never get to draw them
+		m_leftoverWrites = m_usesTransientVertices ? 1 : static_cast<uint32_t>(m_commandBuffers.size());
+		m_geometryGeneration = m_geometryArena->getGeneration();
+		m_indirectGeneration = getIndirectGeneration();
 	}
 
 	vk::CommandBuffer& CommandBuffer::get()
 	{
 		return *m_commandBuffers[m_readIndex];
 	}
+
+	uint64_t CommandBuffer::getIndirectGeneration() const
+	{
+		// Generations only ever grow, so the sum changes whenever any of them does
+		uint64_t generation = 0;
+		for (const auto* buffer : m_indirectBuffers)
+			generation += buffer->getGeneration();
+		return generation;
+	}
+
+	uint8_t* CommandBuffer::append(const CBCmdType type, const uint32_t size)
+	{
+		const auto recordSize = util::alignUp(static_cast<uint32_t>(sizeof(CBCmdHeader)) + size, COMMAND_ALIGNMENT);
+		const auto offset = m_commands.size();
+		m_commands.resize(offset + recordSize);
+
+		auto* record = m_commands.data() + offset;
+		const CBCmdHeader header{ type, recordSize };
+		memcpy(record, &header, sizeof(CBCmdHeader));
+		return record + sizeof(CBCmdHeader);
+	}
+
+	void CommandBuffer::replay(vk::CommandBuffer& cmd) const
+	{
+		const auto* record = m_commands.data();
+		const auto* end = record + m_commands.size();
+		while (record != end)
+		{
+			const auto& header = *reinterpret_cast<const CBCmdHeader*>(record);
+			switch (header.type)
+			{
+			case CBCmdType::SET_VIEWPORT_SCISSOR:
+				recordCommand(cmd, read<CBCmdSetViewportScissor>(record));
+				break;
+			case CBCmdType::SET_VIEWPORT:
+				recordCommand(cmd, read<CBCmdSetViewport>(record));
+				break;
+			case CBCmdType::SET_SCISSOR:
+				recordCommand(cmd, read<CBCmdSetScissor>(record));
+				break;
+			case CBCmdType::BIND_UNIFORM:
+				recordCommand(cmd, read<CBCmdBindUniform>(record));
+				break;
+			case CBCmdType::BIND_TEXTURE:
+				recordCommand(cmd, read<CBCmdBindTexture>(record));
+				break;
+			case CBCmdType::PUSH_CONSTANTS:
+				recordCommand(cmd, read<CBCmdPushConstants>(record));
+				break;
+			case CBCmdType::DRAW:
+				recordCommand(cmd, read<CBCmdDraw>(record));
+				break;
+			case CBCmdType::DRAW_INDEXED:
+				recordCommand(cmd, read<CBCmdDrawIndexed>(record));
+				break;
+			case CBCmdType::DRAW_INDIRECT:
+				recordCommand(cmd, read<CBCmdDrawIndirect>(record));
+				break;
+			case CBCmdType::DRAW_TRANSIENT:
+				recordCommand(cmd, read<CBCmdDrawTransient>(record));
+				break;
+			case CBCmdType::DRAW_INDEXED_TRANSIENT:
+				recordCommand(cmd, read<CBCmdDrawIndexedTransient>(record));
+				break;
+			}
+			record += header.size;
+		}
+	}
 }
@@ -1,150 +1,119 @@
 ﻿#pragma once
+#include <cstring>
+#include <type_traits>
+#include <unordered_set>
+
 #include "vk_context.h"
 #include "vk_framebuffer_format.h"
+#include "vk_geometry_arena.h"
+#include "vk_transient_vertex_allocator.h"
 #include "../../render/command_buffer.h"
 
 namespace digbuild::platform::desktop::vulkan
 {
-	class CBCmd
+	class IndexBuffer;
+	class IndirectDrawBuffer;
+	class TextureBinding;
+	class UniformBinding;
+	class VertexBuffer;
+
+	enum class CBCmdType : uint32_t
 	{
-	public:
-		CBCmd() = default;
-		virtual ~CBCmd() = default;
-		CBCmd(const CBCmd& other) = delete;
-		CBCmd(CBCmd&& other) noexcept = delete;
-		CBCmd& operator=(const CBCmd& other) = delete;
-		CBCmd& operator=(CBCmd&& other) noexcept = delete;
-		
-		virtual void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) = 0;
+		SET_VIEWPORT_SCISSOR,
+		SET_VIEWPORT,
+		SET_SCISSOR,
+		BIND_UNIFORM,
+		BIND_TEXTURE,
+		PUSH_CONSTANTS,
+		DRAW,
+		DRAW_INDEXED,
+		DRAW_INDIRECT,
+		DRAW_TRANSIENT,
+		DRAW_INDEXED_TRANSIENT
 	};
 
-	class CBCmdBegin final : public CBCmd
+	// Commands are stored back to back in a byte stream, each record starting with this header.
+	// The size covers the header, the command and any trailing data.
+	struct CBCmdHeader
 	{
-	public:
-		explicit CBCmdBegin(std::shared_ptr<FramebufferFormat> format) :
-			m_format(std::move(format)) { }
+		CBCmdType type;
+		uint32_t size;
+	};
 
-		void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) override;
-	private:
-		std::shared_ptr<FramebufferFormat> m_format;
+	// Pipeline state is resolved to Vulkan handles as commands are added. Buffers, bindings and render targets
+	// can change between stages, so they are kept as pointers and read every time the stream is replayed.
+	// The command buffer retains all of them for as long as the stream uses them.
+	struct CBCmdSetViewportScissor
+	{
+		render::IRenderTarget* renderTarget;
 	};
-	class CBCmdEnd final : public CBCmd
+	struct CBCmdSetViewport
 	{
-	public:
-		explicit CBCmdEnd() { }
-
-		void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) override;
+		platform::util::Extents2D extents;
 	};
-	class CBCmdSetViewportScissor final : public CBCmd
+	struct CBCmdSetScissor
 	{
-	public:
-		explicit CBCmdSetViewportScissor(std::shared_ptr<render::IRenderTarget> renderTarget) :
-			m_renderTarget(std::move(renderTarget)) { }
-
-		void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) override;
-	private:
-		std::shared_ptr<render::IRenderTarget> m_renderTarget;
+		platform::util::Extents2D extents;
 	};
-	class CBCmdSetViewport final : public CBCmd
+	struct CBCmdBindUniform
 	{
-	public:
-		explicit CBCmdSetViewport(const platform::util::Extents2D extents) :
-			m_extents(extents) { }
-
-		void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) override;
-	private:
-		platform::util::Extents2D m_extents;
+		vk::PipelineLayout layout;
+		uint32_t set;
+		uint32_t binding;
+		UniformBinding* uniformBinding;
 	};
-	class CBCmdSetScissor final : public CBCmd
+	struct CBCmdBindTexture
 	{
-	public:
-		explicit CBCmdSetScissor(const platform::util::Extents2D extents) :
-			m_extents(extents) { }
-
-		void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) override;
-	private:
-		platform::util::Extents2D m_extents;
+		vk::PipelineLayout layout;
+		uint32_t set;
+		TextureBinding* binding;
 	};
-	class CBCmdBindUniform final : public CBCmd
+	// Followed by the pushed data
+	struct CBCmdPushConstants
 	{
-	public:
-		explicit CBCmdBindUniform(
-			std::shared_ptr<render::RenderPipeline> pipeline,
-			std::shared_ptr<render::UniformBinding> uniformBinding,
-			const uint32_t binding
-		) :
-			m_pipeline(std::move(pipeline)),
-			m_uniformBinding(std::move(uniformBinding)),
-			m_binding(binding)
-		{ }
-
-		void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) override;
-	private:
-		std::shared_ptr<render::RenderPipeline> m_pipeline;
-		std::shared_ptr<render::UniformBinding> m_uniformBinding;
-		uint32_t m_binding;
+		vk::PipelineLayout layout;
+		vk::ShaderStageFlags stages;
+		uint32_t offset;
+		uint32_t size;
 	};
-	class CBCmdBindTexture final : public CBCmd
+	struct CBCmdDraw
 	{
-	public:
-		explicit CBCmdBindTexture(
-			std::shared_ptr<render::RenderPipeline> pipeline,
-			std::shared_ptr<render::TextureBinding> binding
-		) :
-			m_pipeline(std::move(pipeline)),
-			m_binding(std::move(binding))
-		{ }
-
-		void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) override;
-	private:
-		std::shared_ptr<render::RenderPipeline> m_pipeline;
-		std::shared_ptr<render::TextureBinding> m_binding;
+		vk::Pipeline pipeline;
+		VertexBuffer* vertexBuffer;
+		VertexBuffer* instanceBuffer;
+		render::DrawRange range;
 	};
-	class CBCmdDraw final : public CBCmd
+	struct CBCmdDrawIndexed
 	{
-	public:
-		explicit CBCmdDraw(
-			std::shared_ptr<render::RenderPipeline> pipeline,
-			std::shared_ptr<render::VertexBuffer> vertexBuffer,
-			std::shared_ptr<render::VertexBuffer> instanceBuffer
-		) :
-			m_pipeline(std::move(pipeline)),
-			m_vertexBuffer(std::move(vertexBuffer)),
-			m_instanceBuffer(std::move(instanceBuffer))
-		{ }
-
-		void record(
-			vk::CommandBuffer& cmd,
-			std::vector<std::shared_ptr<render::Resource>>& resources
-		) override;
-	private:
-		std::shared_ptr<render::RenderPipeline> m_pipeline;
-		std::shared_ptr<render::VertexBuffer> m_vertexBuffer;
-		std::shared_ptr<render::VertexBuffer> m_instanceBuffer;
+		vk::Pipeline pipeline;
+		VertexBuffer* vertexBuffer;
+		IndexBuffer* indexBuffer;
+		VertexBuffer* instanceBuffer;
+		render::DrawIndexedRange range;
+	};
+	struct CBCmdDrawIndirect
+	{
+		vk::Pipeline pipeline;
+		VertexBuffer* vertexBuffer;
+		IndexBuffer* indexBuffer;
+		VertexBuffer* instanceBuffer;
+		IndirectDrawBuffer* indirectBuffer;
+	};
+	// Transient vertices never outlive the recording, so they are resolved as the command is added
+	struct CBCmdDrawTransient
+	{
+		vk::Pipeline pipeline;
+		TransientVertexLocation vertices;
+		VertexBuffer* instanceBuffer;
+		render::DrawRange range;
+	};
+	struct CBCmdDrawIndexedTransient
+	{
+		vk::Pipeline pipeline;
+		TransientVertexLocation vertices;
+		IndexBuffer* indexBuffer;
+		VertexBuffer* instanceBuffer;
+		render::DrawIndexedRange range;
 	};
 	
 	class CommandBuffer final : public render::CommandBuffer, public util::ScalableStagingResource
@@ -152,6 +121,8 @@ namespace digbuild::platform::desktop::vulkan
 	public:
 		CommandBuffer(
 			std::shared_ptr<VulkanContext> context,
+			std::shared_ptr<GeometryArena> geometryArena,
+			std::shared_ptr<TransientVertexAllocator> transientVertexAllocator,
 			uint32_t stages
 		);
 
@@ -160,34 +131,95 @@ namespace digbuild::platform::desktop::vulkan
 		void reserve(uint32_t stages) override;
 		
 		void beginRecording(const std::shared_ptr<render::FramebufferFormat>& format) override;
-		void setViewportAndScissor(std::shared_ptr<render::IRenderTarget> renderTarget) override;
+		[[nodiscard]] bool isRetained(const Resource* resource) const override;
+		void retain(std::shared_ptr<Resource> resource) override;
+		void setViewportAndScissor(render::IRenderTarget* renderTarget) override;
 		void setViewport(platform::util::Extents2D extents) override;
 		void setScissor(platform::util::Extents2D extents) override;
 		void bindUniform(
-			std::shared_ptr<render::RenderPipeline> pipeline,
-			std::shared_ptr<render::UniformBinding> uniformBinding,
+			render::RenderPipeline* pipeline,
+			render::UniformBinding* uniformBinding,
 			uint32_t binding
 		) override;
 		void bindTexture(
-			std::shared_ptr<render::RenderPipeline> pipeline,
-			std::shared_ptr<render::TextureBinding> binding
+			render::RenderPipeline* pipeline,
+			render::TextureBinding* binding
+		) override;
+		void pushConstants(
+			render::RenderPipeline* pipeline,
+			uint32_t offset,
+			const uint8_t* data,
+			uint32_t size
 		) override;
 		void draw(
-			std::shared_ptr<render::RenderPipeline> pipeline,
-			std::shared_ptr<render::VertexBuffer> vertexBuffer,
-			std::shared_ptr<render::VertexBuffer> instanceBuffer
+			render::RenderPipeline* pipeline,
+			render::VertexBuffer* vertexBuffer,
+			render::VertexBuffer* instanceBuffer,
+			render::DrawRange range
+		) override;
+		void drawIndexed(
+			render::RenderPipeline* pipeline,
+			render::VertexBuffer* vertexBuffer,
+			render::IndexBuffer* indexBuffer,
+			render::VertexBuffer* instanceBuffer,
+			render::DrawIndexedRange range
+		) override;
+		void drawTransient(
+			render::RenderPipeline* pipeline,
+			const render::TransientVertexRange& vertices,
+			render::VertexBuffer* instanceBuffer,
+			render::DrawRange range
+		) override;
+		void drawIndexedTransient(
+			render::RenderPipeline* pipeline,
+			const render::TransientVertexRange& vertices,
+			render::IndexBuffer* indexBuffer,
+			render::VertexBuffer* instanceBuffer,
+			render::DrawIndexedRange range
+		) override;
+		void drawIndirect(
+			render::RenderPipeline* pipeline,
+			render::VertexBuffer* vertexBuffer,
+			render::IndexBuffer* indexBuffer,
+			render::VertexBuffer* instanceBuffer,
+			render::IndirectDrawBuffer* indirectBuffer
 		) override;
 		void finishRecording() override;
 
 		[[nodiscard]] vk::CommandBuffer& get();
 
 	private:
+		uint8_t* append(CBCmdType type, uint32_t size);
+		template<typename T>
+		void push(const CBCmdType type, const T& command)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			memcpy(append(type, sizeof(T)), &command, sizeof(T));
+		}
+		void replay(vk::CommandBuffer& cmd) const;
+		[[nodiscard]] uint64_t getIndirectGeneration() const;
+
 		std::shared_ptr<VulkanContext> m_context;
+		std::shared_ptr<GeometryArena> m_geometryArena;
+		std::shared_ptr<TransientVertexAllocator> m_transientVertexAllocator;
 
 		std::vector<vk::UniqueCommandBuffer> m_commandBuffers;
 		std::vector<std::vector<std::shared_ptr<Resource>>> m_resources;
-		std::vector<std::unique_ptr<CBCmd>> m_commandQueue;
+		std::shared_ptr<FramebufferFormat> m_format;
+		std::vector<uint8_t> m_commands;
+		// Everything the command stream points to, once each, handed to every stage as it is recorded
+		std::vector<std::shared_ptr<Resource>> m_retained;
+		std::unordered_set<const Resource*> m_retainedSet;
 		uint32_t m_readIndex = 0;
 		uint32_t m_leftoverWrites = 0;
+		// Set when drawing arena geometry, whose location must be recorded again after compaction
+		bool m_usesGeometryArena = false;
+		uint64_t m_geometryGeneration = 0;
+		// Indirect draws bake in their counts, so they are recorded again whenever those change
+		std::vector<IndirectDrawBuffer*> m_indirectBuffers;
+		uint64_t m_indirectGeneration = 0;
+		// Set when drawing transient vertices, which are only valid for the frame the commands were recorded in
+		bool m_usesTransientVertices = false;
+		bool m_recordedTransientVertices = false;
 	};
 }
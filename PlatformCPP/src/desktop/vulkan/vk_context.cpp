@@ -1,11 +1,17 @@
 #include "vk_context.h"
 
 #include <iostream>
+#include <optional>
 
 #include "vk_util.h"
 
 namespace digbuild::platform::desktop::vulkan
 {
+	constexpr vk::MemoryPropertyFlags DIRECT_MEMORY_PROPERTIES =
+		vk::MemoryPropertyFlagBits::eDeviceLocal |
+		vk::MemoryPropertyFlagBits::eHostVisible |
+		vk::MemoryPropertyFlagBits::eHostCoherent;
+
 	std::vector<const char*> getRequiredLayers()
 	{
 		return std::vector<const char*>{
@@ -121,14 +127,30 @@ namespace digbuild::platform::desktop::vulkan
 		
 		const auto deviceDescriptor = util::findOptimalPhysicalDevice(*m_instance, surface, m_requiredDeviceExtensions);
 		m_physicalDevice = deviceDescriptor.device;
+		m_physicalDeviceProperties = m_physicalDevice.getProperties();
 		m_familyIndices = deviceDescriptor.familyIndices;
 
-		m_device = util::createLogicalDevice(m_physicalDevice, m_familyIndices, m_requiredLayers, m_requiredDeviceExtensions);
+		auto enabledExtensions = m_requiredDeviceExtensions;
+		m_drawIndirectCount = util::areAllExtensionsSupported(m_physicalDevice, { VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME });
+		if (m_drawIndirectCount)
+			enabledExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+		const auto supportedFeatures = m_physicalDevice.getFeatures();
+		m_enabledFeatures = vk::PhysicalDeviceFeatures{};
+		m_enabledFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+		m_enabledFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+		m_enabledFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
+
+		m_device = util::createLogicalDevice(m_physicalDevice, m_familyIndices, m_requiredLayers, enabledExtensions, m_enabledFeatures);
 		
 		m_graphicsQueue = m_device->getQueue(m_familyIndices.graphicsFamily.value(), 0);
 		m_presentQueue = m_device->getQueue(m_familyIndices.presentFamily.value(), 0);
+		if (m_familyIndices.transferFamily.has_value())
+			m_transferQueue = m_device->getQueue(m_familyIndices.transferFamily.value(), 0);
 		
 		m_commandPool = util::createCommandPool(*m_device, m_familyIndices.graphicsFamily.value());
+		if (m_familyIndices.transferFamily.has_value())
+			m_transferCommandPool = util::createCommandPool(*m_device, m_familyIndices.transferFamily.value());
 		m_pipelineCache = util::createPipelineCache(*m_device);
 		
 		m_memoryAllocator = vma::createAllocator({
@@ -138,6 +160,24 @@ namespace digbuild::platform::desktop::vulkan
 			*m_instance, VK_API_VERSION_1_0
 		});
 
+		// Host-visible device-local memory is only written to directly when it spans the main device-local heap,
+		// as without resizable BAR discrete GPUs only expose a small window of it
+		const auto memoryProperties = m_physicalDevice.getMemoryProperties();
+		std::optional<uint32_t> mainHeap;
+		for (auto i = 0u; i < memoryProperties.memoryHeapCount; ++i)
+		{
+			const auto& heap = memoryProperties.memoryHeaps[i];
+			if ((heap.flags & vk::MemoryHeapFlagBits::eDeviceLocal) &&
+				(!mainHeap || heap.size > memoryProperties.memoryHeaps[*mainHeap].size))
+				mainHeap = i;
+		}
+		for (auto i = 0u; i < memoryProperties.memoryTypeCount; ++i)
+		{
+			const auto& type = memoryProperties.memoryTypes[i];
+			if ((type.propertyFlags & DIRECT_MEMORY_PROPERTIES) == DIRECT_MEMORY_PROPERTIES && type.heapIndex == mainHeap)
+				m_directMemoryTypeBits |= 1u << i;
+		}
+
 		m_deviceInitialized = true;
 		return true;
 	}
@@ -153,6 +193,8 @@ namespace digbuild::platform::desktop::vulkan
 			m_presentQueue.waitIdle();
 		if (m_graphicsQueue)
 			m_graphicsQueue.waitIdle();
+		if (m_transferQueue)
+			m_transferQueue.waitIdle();
 		if (m_device)
 			m_device->waitIdle();
 	}
@@ -197,7 +239,7 @@ namespace digbuild::platform::desktop::vulkan
 		std::vector<vk::UniqueImageView> views;
 		views.reserve(images.size());
 		for (const auto& image : images)
-			views.push_back(createImageView(image, format, vk::ImageAspectFlagBits::eColor));
+			views.push_back(createImageView(image, vk::ImageViewType::e2D, format, vk::ImageAspectFlagBits::eColor, 1, 1));
 		return std::move(views);
 	}
 
@@ -229,6 +271,7 @@ namespace digbuild::platform::desktop::vulkan
 
 	std::unique_ptr<VulkanImage> VulkanContext::createImage(
 		const uint32_t width, const uint32_t height,
+		const uint32_t mipLevels, const uint32_t layers,
 		const vk::Format format,
 		const vk::ImageUsageFlags usageFlags,
 		const vk::MemoryPropertyFlags memoryProperties
@@ -237,7 +280,7 @@ namespace digbuild::platform::desktop::vulkan
 		const auto queueIndex = m_familyIndices.graphicsFamily.value();
 		auto image = m_device->createImageUnique({
 			{}, vk::ImageType::e2D, format,
-			vk::Extent3D{width, height, 1}, 1, 1,
+			vk::Extent3D{width, height, 1}, mipLevels, layers,
 			vk::SampleCountFlagBits::e1,
 			vk::ImageTiling::eOptimal,
 			usageFlags,
@@ -258,19 +301,21 @@ namespace digbuild::platform::desktop::vulkan
 
 	[[nodiscard]] vk::UniqueImageView VulkanContext::createImageView(
 		const vk::Image& image,
+		const vk::ImageViewType viewType,
 		const vk::Format format,
-		const vk::ImageAspectFlags aspectFlags
+		const vk::ImageAspectFlags aspectFlags,
+		const uint32_t mipLevels, const uint32_t layers
 	) const
 	{
 		return m_device->createImageViewUnique({
 			{},
 			image,
-			vk::ImageViewType::e2D,
+			viewType,
 			format,
 			{},
 			vk::ImageSubresourceRange{
 				aspectFlags,
-				0, 1, 0, 1
+				0, mipLevels, 0, layers
 			}
 		});
 	}
@@ -392,6 +437,18 @@ namespace digbuild::platform::desktop::vulkan
 		return util::StagingResource(std::move(commandBuffers));
 	}
 
+	[[nodiscard]] util::StagingResource<vk::CommandBuffer> VulkanContext::createTransferCommandBuffer(
+		const uint32_t stages
+	) const
+	{
+		auto commandBuffers = m_device->allocateCommandBuffersUnique({
+			*m_transferCommandPool,
+			vk::CommandBufferLevel::ePrimary,
+			stages
+		});
+		return util::StagingResource(std::move(commandBuffers));
+	}
+
 	[[nodiscard]] std::unique_ptr<VulkanBuffer> VulkanContext::createBuffer(
 		const uint32_t size,
 		const vk::BufferUsageFlags usage,
@@ -434,6 +491,72 @@ namespace digbuild::platform::desktop::vulkan
 		return std::make_unique<VulkanBuffer>(shared_from_this(), std::move(buffer), memoryAllocation, size);
 	}
 
+	[[nodiscard]] std::unique_ptr<VulkanBuffer> VulkanContext::createMappedBuffer(
+		const uint32_t size,
+		const vk::BufferUsageFlags usage
+	)
+	{
+		auto buffer = m_device->createBufferUnique({ {}, size, usage, vk::SharingMode::eExclusive });
+		vma::AllocationInfo allocationInfo;
+		const auto memoryAllocation = m_memoryAllocator.allocateMemoryForBuffer(
+			*buffer,
+			{
+				vma::AllocationCreateFlagBits::eMapped,
+				vma::MemoryUsage::eCpuToGpu,
+				vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+			},
+			allocationInfo
+		);
+		m_memoryAllocator.bindBufferMemory(memoryAllocation, *buffer);
+		return std::make_unique<VulkanBuffer>(
+			shared_from_this(),
+			std::move(buffer),
+			memoryAllocation,
+			size,
+			allocationInfo.pMappedData
+		);
+	}
+
+	[[nodiscard]] std::unique_ptr<VulkanBuffer> VulkanContext::createDirectBuffer(
+		const uint32_t size,
+		const vk::BufferUsageFlags usage
+	)
+	{
+		if (!supportsDirectWrite())
+			return nullptr;
+
+		auto buffer = m_device->createBufferUnique({ {}, size, usage, vk::SharingMode::eExclusive });
+		vma::AllocationInfo allocationInfo;
+		vma::Allocation memoryAllocation;
+		try
+		{
+			memoryAllocation = m_memoryAllocator.allocateMemoryForBuffer(
+				*buffer,
+				{
+					vma::AllocationCreateFlagBits::eMapped | vma::AllocationCreateFlagBits::eWithinBudget,
+					vma::MemoryUsage::eUnknown,
+					DIRECT_MEMORY_PROPERTIES,
+					{},
+					m_directMemoryTypeBits
+				},
+				allocationInfo
+			);
+		}
+		catch (const vk::SystemError&)
+		{
+			return nullptr;
+		}
+		m_memoryAllocator.bindBufferMemory(memoryAllocation, *buffer);
+		return std::make_unique<VulkanBuffer>(
+			shared_from_this(),
+			std::move(buffer),
+			memoryAllocation,
+			size,
+			allocationInfo.pMappedData,
+			true
+		);
+	}
+
 	vk::UniqueShaderModule VulkanContext::createShaderModule(
 		const std::vector<uint8_t>& bytes
 	) const
@@ -532,6 +655,11 @@ namespace digbuild::platform::desktop::vulkan
 			throw std::runtime_error("Failed to reset fence.");
 	}
 
+	bool VulkanContext::isSignaled(const vk::Fence& fence) const
+	{
+		return m_device->getFenceStatus(fence) == vk::Result::eSuccess;
+	}
+
 	vk::ResultValue<uint32_t> VulkanContext::acquireNextImage(
 		const vk::SwapchainKHR& swapChain,
 		const vk::Semaphore& semaphore
@@ -558,6 +686,53 @@ namespace digbuild::platform::desktop::vulkan
 			throw std::runtime_error("Failed to submit work.");
 	}
 
+	void VulkanContext::submit(
+		const vk::CommandBuffer& commandBuffer,
+		const vk::Fence& fence
+	) const
+	{
+		vk::SubmitInfo submitInfo{
+			0, nullptr, nullptr,
+			1, &commandBuffer
+		};
+		const auto result = m_graphicsQueue.submit(1, &submitInfo, fence);
+		if (result != vk::Result::eSuccess)
+			throw std::runtime_error("Failed to submit work.");
+	}
+
+	void VulkanContext::submit(
+		const vk::CommandBuffer& commandBuffer,
+		const std::vector<vk::Semaphore>& waitSemaphores,
+		const std::vector<vk::PipelineStageFlags>& waitStages,
+		const vk::Semaphore& signalSemaphore,
+		const vk::Fence& fence
+	) const
+	{
+		vk::SubmitInfo submitInfo{
+			static_cast<uint32_t>(waitSemaphores.size()), waitSemaphores.data(), waitStages.data(),
+			1, &commandBuffer,
+			signalSemaphore ? 1u : 0u, &signalSemaphore
+		};
+		const auto result = m_graphicsQueue.submit(1, &submitInfo, fence);
+		if (result != vk::Result::eSuccess)
+			throw std::runtime_error("Failed to submit work.");
+	}
+
+	void VulkanContext::submitTransfer(
+		const vk::CommandBuffer& commandBuffer,
+		const vk::Semaphore& signalSemaphore
+	) const
+	{
+		vk::SubmitInfo submitInfo{
+			0, nullptr, nullptr,
+			1, &commandBuffer,
+			1, &signalSemaphore
+		};
+		const auto result = m_transferQueue.submit(1, &submitInfo, nullptr);
+		if (result != vk::Result::eSuccess)
+			throw std::runtime_error("Failed to submit work.");
+	}
+
 	[[nodiscard]] vk::Result VulkanContext::present(
 		const vk::Semaphore& waitSemaphore,
 		const vk::SwapchainKHR& swapChain,
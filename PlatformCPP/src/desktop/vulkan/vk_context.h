@@ -64,6 +64,7 @@ namespace digbuild::platform::desktop::vulkan
 
 		[[nodiscard]] std::unique_ptr<VulkanImage> createImage(
 			uint32_t width, uint32_t height,
+			uint32_t mipLevels, uint32_t layers,
 			vk::Format format,
 			vk::ImageUsageFlags usageFlags,
 			vk::MemoryPropertyFlags memoryProperties
@@ -71,8 +72,10 @@ namespace digbuild::platform::desktop::vulkan
 
 		[[nodiscard]] vk::UniqueImageView createImageView(
 			const vk::Image& image,
+			vk::ImageViewType viewType,
 			vk::Format format,
-			vk::ImageAspectFlags aspectFlags
+			vk::ImageAspectFlags aspectFlags,
+			uint32_t mipLevels, uint32_t layers
 		) const;
 
 		[[nodiscard]] vk::UniqueFramebuffer createFramebuffer(
@@ -107,6 +110,10 @@ namespace digbuild::platform::desktop::vulkan
 			vk::CommandBufferLevel level
 		) const;
 
+		[[nodiscard]] util::StagingResource<vk::CommandBuffer> createTransferCommandBuffer(
+			uint32_t stages
+		) const;
+
 		[[nodiscard]] std::unique_ptr<VulkanBuffer> createBuffer(
 			uint32_t size,
 			vk::BufferUsageFlags usage,
@@ -118,6 +125,18 @@ namespace digbuild::platform::desktop::vulkan
 			const void* data,
 			uint32_t size
 		);
+
+		[[nodiscard]] std::unique_ptr<VulkanBuffer> createMappedBuffer(
+			uint32_t size,
+			vk::BufferUsageFlags usage
+		);
+
+		// Creates a persistently mapped buffer in device-local memory, which the host can write to without staging
+		// on devices with resizable BAR or unified memory. Returns null if there is no such memory or it is over budget.
+		[[nodiscard]] std::unique_ptr<VulkanBuffer> createDirectBuffer(
+			uint32_t size,
+			vk::BufferUsageFlags usage
+		);
 		
 		[[nodiscard]] vk::UniqueShaderModule createShaderModule(
 			const std::vector<uint8_t>& bytes
@@ -154,6 +173,7 @@ namespace digbuild::platform::desktop::vulkan
 		
 		void wait(const vk::Fence& fence) const;
 		void reset(const vk::Fence& fence) const;
+		[[nodiscard]] bool isSignaled(const vk::Fence& fence) const;
 		
 		vk::ResultValue<uint32_t> acquireNextImage(
 			const vk::SwapchainKHR& swapChain,
@@ -166,6 +186,24 @@ namespace digbuild::platform::desktop::vulkan
 			const vk::Semaphore& signalSemaphore,
 			const vk::Fence& fence
 		) const;
+
+		void submit(
+			const vk::CommandBuffer& commandBuffer,
+			const vk::Fence& fence
+		) const;
+
+		void submit(
+			const vk::CommandBuffer& commandBuffer,
+			const std::vector<vk::Semaphore>& waitSemaphores,
+			const std::vector<vk::PipelineStageFlags>& waitStages,
+			const vk::Semaphore& signalSemaphore,
+			const vk::Fence& fence
+		) const;
+
+		void submitTransfer(
+			const vk::CommandBuffer& commandBuffer,
+			const vk::Semaphore& signalSemaphore
+		) const;
 		
 		[[nodiscard]] vk::Result present(
 			const vk::Semaphore& waitSemaphore,
@@ -174,6 +212,22 @@ namespace digbuild::platform::desktop::vulkan
 		) const;
 		
 		[[nodiscard]] const vk::Instance& getInstance() { return *m_instance; }
+		[[nodiscard]] const vk::PhysicalDeviceLimits& getLimits() const { return m_physicalDeviceProperties.limits; }
+		[[nodiscard]] bool hasTransferQueue() const { return m_familyIndices.transferFamily.has_value(); }
+		[[nodiscard]] uint32_t getGraphicsFamily() const { return m_familyIndices.graphicsFamily.value(); }
+		[[nodiscard]] uint32_t getTransferFamily() const { return m_familyIndices.transferFamily.value(); }
+		[[nodiscard]] bool supportsMultiDrawIndirect() const { return m_enabledFeatures.multiDrawIndirect; }
+		[[nodiscard]] bool supportsDrawIndirectCount() const { return m_drawIndirectCount; }
+		[[nodiscard]] bool supportsDirectWrite() const { return m_directMemoryTypeBits != 0; }
+		[[nodiscard]] vk::FormatProperties getFormatProperties(const vk::Format format) const { return m_physicalDevice.getFormatProperties(format); }
+		[[nodiscard]] bool supportsFormatFeatures(const vk::Format format, const vk::FormatFeatureFlags features) const
+		{
+			return (getFormatProperties(format).optimalTilingFeatures & features) == features;
+		}
+		[[nodiscard]] bool supportsSampledFormat(const vk::Format format) const
+		{
+			return supportsFormatFeatures(format, vk::FormatFeatureFlagBits::eSampledImage);
+		}
 	
 	private:
 		std::vector<const char*> m_requiredLayers;
@@ -184,14 +238,20 @@ namespace digbuild::platform::desktop::vulkan
 		bool m_deviceInitialized = false;
 		std::vector<const char*> m_requiredDeviceExtensions;
 		vk::PhysicalDevice m_physicalDevice;
+		vk::PhysicalDeviceProperties m_physicalDeviceProperties;
+		vk::PhysicalDeviceFeatures m_enabledFeatures;
+		bool m_drawIndirectCount = false;
+		uint32_t m_directMemoryTypeBits = 0;
 		util::QueueFamilyIndices m_familyIndices;
 		vk::UniqueDevice m_device;
 		vma::Allocator m_memoryAllocator;
 
 		vk::Queue m_graphicsQueue;
 		vk::Queue m_presentQueue;
+		vk::Queue m_transferQueue;
 
 		vk::UniqueCommandPool m_commandPool;
+		vk::UniqueCommandPool m_transferCommandPool;
 		vk::UniquePipelineCache m_pipelineCache;
 
 		friend class VulkanBuffer;
@@ -2,18 +2,6 @@
 
 namespace digbuild::platform::desktop::vulkan
 {
-	vk::ImageAspectFlags toVulkanAspectFlags(const render::FramebufferAttachmentType type)
-	{
-		switch (type)
-		{
-		case render::FramebufferAttachmentType::COLOR:
-			return vk::ImageAspectFlagBits::eColor;
-		case render::FramebufferAttachmentType::DEPTH_STENCIL:
-			return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
-		}
-		throw std::runtime_error("Invalid type.");
-	}
-	
 	vk::ImageUsageFlagBits toVulkanUsageFlags(const render::FramebufferAttachmentType type)
 	{
 		switch (type)
@@ -28,6 +16,7 @@ namespace digbuild::platform::desktop::vulkan
 
 	Framebuffer::Framebuffer(
 		std::shared_ptr<VulkanContext> context,
+		const std::shared_ptr<UploadStream>& uploadStream,
 		std::shared_ptr<FramebufferFormat> format,
 		const uint32_t width, const uint32_t height,
 		const uint32_t stages
@@ -44,11 +33,14 @@ namespace digbuild::platform::desktop::vulkan
 		std::vector<std::vector<vk::ImageView>> framebufferViews;
 		framebufferViews.resize(stages);
 
+		std::vector<util::ImageTransitionInfo> transitions;
+		transitions.reserve(attachments.size() * stages);
+
 		for (const auto& attachment : attachments)
 		{
 			const auto usageFlags = toVulkanUsageFlags(attachment.type) | vk::ImageUsageFlagBits::eSampled;
 			const auto vkFormat = util::toVulkanFormat(attachment.format);
-			const auto aspectFlags = toVulkanAspectFlags(attachment.type);
+			const auto aspectFlags = util::getAspectFlags(attachment.format);
 
 			std::vector<std::unique_ptr<VulkanImage>> images;
 			std::vector<vk::UniqueImageView> views;
@@ -56,19 +48,19 @@ namespace digbuild::platform::desktop::vulkan
 			views.reserve(stages);
 			for (auto i = 0u; i < stages; ++i)
 			{
-				auto image = m_context->createImage(width, height, vkFormat, usageFlags, vk::MemoryPropertyFlagBits::eDeviceLocal);
-				auto view = m_context->createImageView(image->get(), vkFormat, aspectFlags);
+				auto image = m_context->createImage(width, height, 1, 1, vkFormat, usageFlags, vk::MemoryPropertyFlagBits::eDeviceLocal);
+				auto view = m_context->createImageView(image->get(), vk::ImageViewType::e2D, vkFormat, aspectFlags, 1, 1);
 				
 				framebufferViews[i].push_back(*view);
 
-				util::transitionImageLayoutsImmediate(*m_context->m_device, *m_context->m_commandPool, m_context->m_graphicsQueue, {{
+				transitions.push_back({
 					image->get(),
 					aspectFlags,
 					vk::ImageLayout::eUndefined,
 					attachment.type == render::FramebufferAttachmentType::COLOR ?
 						vk::ImageLayout::eColorAttachmentOptimal :
 						vk::ImageLayout::eDepthStencilAttachmentOptimal
-				}});
+				});
 				
 				images.push_back(std::move(image));
 				views.push_back(std::move(view));
@@ -83,6 +75,16 @@ namespace digbuild::platform::desktop::vulkan
 		}
 		
 		m_framebuffers = m_context->createFramebuffers(m_format->getPass(), { width, height }, framebufferViews);
+
+		// The images cannot be rendered to before the next frame, so their initial transitions are
+		// folded into a single barrier at the start of it instead of stalling the device here
+		uploadStream->enqueue(
+			[transitions = std::move(transitions)](const vk::CommandBuffer& cmd)
+			{
+				util::transitionImageLayouts(cmd, transitions);
+			},
+			std::vector<std::shared_ptr<void>>(m_textures.begin(), m_textures.end())
+		);
 	}
 
 	Framebuffer::Framebuffer(
@@ -128,7 +130,7 @@ namespace digbuild::platform::desktop::vulkan
 			const auto& attachment = attachments[i];
 			util::transitionImageLayouts(cmd, {{
 				texture->m_images[texture->m_readIndex]->get(),
-				toVulkanAspectFlags(attachment.type),
+				util::getAspectFlags(attachment.format),
 				attachment.type == render::FramebufferAttachmentType::COLOR ?
 					vk::ImageLayout::eColorAttachmentOptimal :
 					vk::ImageLayout::eDepthStencilAttachmentOptimal,
@@ -32,6 +32,11 @@ namespace digbuild::platform::desktop::vulkan
 			return m_height;
 		}
 
+		[[nodiscard]] bool isReady() override
+		{
+			return true;
+		}
+
 		[[nodiscard]] vk::ImageView& get() override
 		{
 			return *m_imageViews[m_readIndex];
@@ -52,6 +57,7 @@ namespace digbuild::platform::desktop::vulkan
 	public:
 		Framebuffer(
 			std::shared_ptr<VulkanContext> context,
+			const std::shared_ptr<UploadStream>& uploadStream,
 			std::shared_ptr<FramebufferFormat> format,
 			uint32_t width, uint32_t height,
 			uint32_t stages
@@ -46,6 +46,15 @@ namespace digbuild::platform::desktop::vulkan
 		attachmentReferences.reserve(m_attachments.size());
 		for (const auto& attachment : m_attachments)
 		{
+			const auto depth = attachment.type == render::FramebufferAttachmentType::DEPTH_STENCIL;
+			if (depth != render::isDepthFormat(attachment.format))
+				throw std::runtime_error("Attachment format does not match the attachment type.");
+			if (!m_context->supportsFormatFeatures(
+				util::toVulkanFormat(attachment.format),
+				util::getAttachmentFormatFeatures(attachment.format)
+			))
+				throw std::runtime_error("Attachment format is not supported by the device.");
+
 			const auto i = static_cast<uint32_t>(attachmentDescriptions.size());
 			const auto description = toVulkan(attachment);
 			attachmentDescriptions.push_back(description);
@@ -0,0 +1,176 @@
+﻿#include "vk_geometry_arena.h"
+
+#include <algorithm>
+
+namespace digbuild::platform::desktop::vulkan
+{
+	// Covers the alignment of every vertex attribute format
+	constexpr uint32_t GEOMETRY_ALIGNMENT = 16;
+	// Pages are only compacted while less than this fraction of them is in use
+	constexpr float COMPACTION_THRESHOLD = 0.5f;
+
+	GeometryAllocation::GeometryAllocation(
+		std::shared_ptr<GeometryArena> arena,
+		GeometryPage* page,
+		const uint32_t offset,
+		const uint32_t size,
+		const uint64_t frame
+	) :
+		m_arena(std::move(arena)),
+		m_page(page),
+		m_offset(offset),
+		m_size(size),
+		m_frame(frame)
+	{
+	}
+
+	GeometryAllocation::~GeometryAllocation()
+	{
+		m_arena->free(*this);
+	}
+
+	GeometryArena::GeometryArena(
+		std::shared_ptr<VulkanContext> context,
+		const uint32_t pageSize
+	) :
+		m_context(std::move(context)),
+		m_pageSize(pageSize)
+	{
+	}
+
+	std::shared_ptr<GeometryAllocation> GeometryArena::allocate(uint32_t size)
+	{
+		size = util::alignUp(std::max(size, 1u), GEOMETRY_ALIGNMENT);
+
+		std::scoped_lock lock(m_lock);
+
+		GeometryPage* target = nullptr;
+		std::optional<uint32_t> offset;
+		for (auto& page : m_pages)
+		{
+			offset = page->ranges.allocate(size, GEOMETRY_ALIGNMENT);
+			if (offset)
+			{
+				target = page.get();
+				break;
+			}
+		}
+
+		if (!target)
+		{
+			// Geometry that would not fit in a regular page gets one of its own
+			const auto pageSize = std::max(size, m_pageSize);
+			target = m_pages.emplace_back(std::make_unique<GeometryPage>(GeometryPage{
+				m_context->createBuffer(
+					pageSize,
+					vk::BufferUsageFlagBits::eVertexBuffer |
+					vk::BufferUsageFlagBits::eIndexBuffer |
+					vk::BufferUsageFlagBits::eTransferSrc |
+					vk::BufferUsageFlagBits::eTransferDst,
+					vk::SharingMode::eExclusive,
+					{}
+				),
+				util::RangeAllocator(pageSize),
+				{}
+			})).get();
+			offset = target->ranges.allocate(size, GEOMETRY_ALIGNMENT);
+		}
+
+		auto allocation = std::make_shared<GeometryAllocation>(shared_from_this(), target, *offset, size, m_frame);
+		target->allocations.insert(allocation.get());
+		return allocation;
+	}
+
+	void GeometryArena::compact(UploadStream& uploadStream, uint32_t budget)
+	{
+		std::scoped_lock lock(m_lock);
+
+		// Anything allocated since the last call is still waiting for its upload, which shares the same frame
+		const auto frame = m_frame++;
+
+		// Empty pages are no longer referenced by any frame in flight, as ranges are only freed once retired
+		for (auto it = m_pages.begin(); it != m_pages.end() && m_pages.size() > 1;)
+		{
+			if ((*it)->ranges.empty())
+			{
+				uploadStream.retain((*it)->buffer);
+				it = m_pages.erase(it);
+				continue;
+			}
+			++it;
+		}
+
+		if (m_pages.size() < 2 || budget == 0)
+			return;
+
+		GeometryPage* source = nullptr;
+		uint64_t available = 0;
+		for (auto& page : m_pages)
+		{
+			available += page->ranges.size() - page->ranges.used();
+			if (!source || page->ranges.used() < source->ranges.used())
+				source = page.get();
+		}
+		available -= source->ranges.size() - source->ranges.used();
+
+		if (source->ranges.used() >= source->ranges.size() * COMPACTION_THRESHOLD || source->ranges.used() > available)
+			return;
+
+		auto moved = false;
+		for (auto it = source->allocations.begin(); it != source->allocations.end() && budget > 0;)
+		{
+			auto* allocation = *it;
+			if (allocation->m_frame >= frame)
+			{
+				++it;
+				continue;
+			}
+
+			GeometryPage* target = nullptr;
+			std::optional<uint32_t> offset;
+			for (auto& page : m_pages)
+			{
+				if (page.get() == source)
+					continue;
+				offset = page->ranges.allocate(allocation->m_size, GEOMETRY_ALIGNMENT);
+				if (offset)
+				{
+					target = page.get();
+					break;
+				}
+			}
+			if (!target)
+				break;
+
+			uploadStream.copyBufferRegions(
+				source->buffer,
+				target->buffer,
+				{ vk::BufferCopy{ allocation->m_offset, *offset, allocation->m_size } }
+			);
+
+			// The old range stays reserved until the frames that may still read from it have retired
+			uploadStream.retain(std::make_shared<GeometryAllocation>(
+				shared_from_this(), source, allocation->m_offset, allocation->m_size, allocation->m_frame
+			));
+
+			it = source->allocations.erase(it);
+			allocation->m_page = target;
+			allocation->m_offset = *offset;
+			target->allocations.insert(allocation);
+
+			budget -= std::min(budget, allocation->m_size);
+			moved = true;
+		}
+
+		if (moved)
+			m_generation++;
+	}
+
+	void GeometryArena::free(GeometryAllocation& allocation)
+	{
+		std::scoped_lock lock(m_lock);
+
+		allocation.m_page->ranges.free(allocation.m_offset, allocation.m_size);
+		allocation.m_page->allocations.erase(&allocation);
+	}
+}
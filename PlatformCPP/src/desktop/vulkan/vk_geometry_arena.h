@@ -0,0 +1,98 @@
+﻿#pragma once
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include <vulkan.h>
+
+#include "vk_buffer.h"
+#include "vk_context.h"
+#include "vk_range_allocator.h"
+#include "vk_upload_stream.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	class GeometryArena;
+	class GeometryAllocation;
+
+	struct GeometryPage
+	{
+		std::shared_ptr<VulkanBuffer> buffer;
+		util::RangeAllocator ranges;
+		std::unordered_set<GeometryAllocation*> allocations;
+	};
+
+	class GeometryAllocation final
+	{
+	public:
+		GeometryAllocation(
+			std::shared_ptr<GeometryArena> arena,
+			GeometryPage* page,
+			uint32_t offset,
+			uint32_t size,
+			uint64_t frame
+		);
+		~GeometryAllocation();
+		GeometryAllocation(const GeometryAllocation& other) = delete;
+		GeometryAllocation(GeometryAllocation&& other) noexcept = delete;
+		GeometryAllocation& operator=(const GeometryAllocation& other) = delete;
+		GeometryAllocation& operator=(GeometryAllocation&& other) noexcept = delete;
+
+		[[nodiscard]] const std::shared_ptr<VulkanBuffer>& buffer() const
+		{
+			return m_page->buffer;
+		}
+		[[nodiscard]] uint32_t offset() const
+		{
+			return m_offset;
+		}
+		[[nodiscard]] uint32_t size() const
+		{
+			return m_size;
+		}
+
+	private:
+		std::shared_ptr<GeometryArena> m_arena;
+		GeometryPage* m_page;
+		uint32_t m_offset, m_size;
+		uint64_t m_frame;
+
+		friend class GeometryArena;
+	};
+
+	// Suballocates static geometry from large device-local buffers. Allocations may be moved by compaction,
+	// which bumps the generation so that anything that recorded their location knows to record it again.
+	class GeometryArena final : public std::enable_shared_from_this<GeometryArena>
+	{
+	public:
+		GeometryArena(
+			std::shared_ptr<VulkanContext> context,
+			uint32_t pageSize
+		);
+
+		[[nodiscard]] std::shared_ptr<GeometryAllocation> allocate(uint32_t size);
+
+		// Moves up to the given number of bytes out of the least occupied page, if it is sparse enough to be
+		// emptied into the others, and releases pages that have become empty. Must be called once per frame,
+		// before anything records the location of an allocation.
+		void compact(UploadStream& uploadStream, uint32_t budget);
+
+		[[nodiscard]] uint64_t getGeneration() const
+		{
+			return m_generation;
+		}
+
+	private:
+		void free(GeometryAllocation& allocation);
+
+		std::shared_ptr<VulkanContext> m_context;
+		uint32_t m_pageSize;
+
+		std::mutex m_lock;
+		std::vector<std::unique_ptr<GeometryPage>> m_pages;
+		uint64_t m_frame = 0;
+		uint64_t m_generation = 0;
+
+		friend class GeometryAllocation;
+	};
+}
@@ -0,0 +1,50 @@
+﻿#include "vk_index_buffer.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	IndexBuffer::IndexBuffer(
+		std::shared_ptr<VertexBuffer> storage,
+		const render::IndexType indexType,
+		const bool writable
+	) :
+		m_storage(std::move(storage)),
+		m_indexType(indexType),
+		m_writable(writable)
+	{
+	}
+
+	void IndexBuffer::write(const std::vector<uint8_t>& data)
+	{
+		checkWritable();
+		m_storage->write(data);
+	}
+
+	void IndexBuffer::writeRange(const uint32_t offset, const std::vector<uint8_t>& data)
+	{
+		checkWritable();
+		m_storage->writeRange(offset, data);
+	}
+
+	void* IndexBuffer::map(const uint32_t size)
+	{
+		checkWritable();
+		return m_storage->map(size);
+	}
+
+	void IndexBuffer::commit(const uint32_t size)
+	{
+		checkWritable();
+		m_storage->commit(size);
+	}
+
+	void IndexBuffer::setCapacityPolicy(const render::BufferCapacityPolicy& policy)
+	{
+		m_storage->setCapacityPolicy(policy);
+	}
+
+	void IndexBuffer::checkWritable() const
+	{
+		if (!m_writable)
+			throw std::runtime_error("Cannot write to a static index buffer.");
+	}
+}
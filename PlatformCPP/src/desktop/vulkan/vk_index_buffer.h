@@ -0,0 +1,69 @@
+﻿#pragma once
+#include "vk_vertex_buffer.h"
+#include "../../render/index_buffer.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	// Indices live in vertex buffer storage, so they share its staging path, geometry arena and capacity policy
+	class IndexBuffer final : public render::IndexBuffer
+	{
+	public:
+		IndexBuffer(
+			std::shared_ptr<VertexBuffer> storage,
+			render::IndexType indexType,
+			bool writable
+		);
+
+		[[nodiscard]] render::IndexType getIndexType() override
+		{
+			return m_indexType;
+		}
+
+		void write(const std::vector<uint8_t>& data) override;
+
+		void writeRange(uint32_t offset, const std::vector<uint8_t>& data) override;
+
+		[[nodiscard]] void* map(uint32_t size) override;
+
+		void commit(uint32_t size) override;
+
+		void setCapacityPolicy(const render::BufferCapacityPolicy& policy) override;
+
+		[[nodiscard]] render::BufferStats getStats() override
+		{
+			return m_storage->getStats();
+		}
+
+		[[nodiscard]] vk::Buffer& get()
+		{
+			return m_storage->get();
+		}
+
+		[[nodiscard]] uint32_t offset()
+		{
+			return m_storage->offset();
+		}
+
+		[[nodiscard]] uint32_t size()
+		{
+			return m_storage->size();
+		}
+
+		[[nodiscard]] vk::IndexType getVkIndexType() const
+		{
+			return m_indexType == render::IndexType::UINT16 ? vk::IndexType::eUint16 : vk::IndexType::eUint32;
+		}
+
+		[[nodiscard]] bool isStatic() const
+		{
+			return !m_writable;
+		}
+
+	private:
+		void checkWritable() const;
+
+		std::shared_ptr<VertexBuffer> m_storage;
+		render::IndexType m_indexType;
+		bool m_writable;
+	};
+}
@@ -0,0 +1,137 @@
+﻿#include "vk_indirect_draw_buffer.h"
+
+#include <cstring>
+
+namespace digbuild::platform::desktop::vulkan
+{
+	// The draw count is read from the start of the buffer, and the commands follow it
+	constexpr uint32_t HEADER_SIZE = 16;
+
+	IndirectDrawBuffer::IndirectDrawBuffer(
+		std::shared_ptr<VulkanContext> context,
+		std::shared_ptr<UploadStream> uploadStream,
+		const bool indexed,
+		const std::vector<uint8_t>& data
+	) :
+		m_context(std::move(context)),
+		m_uploadStream(std::move(uploadStream)),
+		m_indexed(indexed)
+	{
+		write(data);
+	}
+
+	IndirectDrawBuffer::~IndirectDrawBuffer()
+	{
+		m_uploadStream->retain(std::move(m_buffer));
+	}
+
+	void IndirectDrawBuffer::write(const std::vector<uint8_t>& data)
+	{
+		const auto commandCount = static_cast<uint32_t>(data.size()) / getCommandSize();
+		const auto size = HEADER_SIZE + commandCount * getCommandSize();
+
+		// The buffer is never ticked, so it only ever grows to fit
+		const auto capacity = m_buffer ? m_buffer->size() : 0;
+		const auto newCapacity = m_capacity.fit(capacity, size);
+		if (!m_buffer || newCapacity > capacity)
+		{
+			if (m_buffer)
+				m_uploadStream->retain(std::move(m_buffer));
+			m_capacity.reallocated();
+			m_buffer = m_context->createBuffer(
+				newCapacity,
+				vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst,
+				vk::SharingMode::eExclusive,
+				{}
+			);
+			m_generation++;
+		}
+
+		std::vector<uint8_t> contents(size);
+		memcpy(contents.data(), &commandCount, sizeof(commandCount));
+		memcpy(contents.data() + HEADER_SIZE, data.data(), size - HEADER_SIZE);
+		m_uploadStream->copyRegionsToBuffer(contents.data(), { vk::BufferCopy{ 0, 0, size } }, m_buffer);
+
+		// Recorded draws hold the command count, and without a count buffer the draw count as well
+		if (commandCount != m_commandCount || (commandCount != m_drawCount && !m_context->supportsDrawIndirectCount()))
+			m_generation++;
+		m_commandCount = commandCount;
+		m_drawCount = commandCount;
+	}
+
+	void IndirectDrawBuffer::writeRange(const uint32_t offset, const std::vector<uint8_t>& data)
+	{
+		const auto commandCount = static_cast<uint32_t>(data.size()) / getCommandSize();
+		if (offset + commandCount > m_commandCount)
+			throw std::runtime_error("Range exceeds the number of draw commands.");
+		if (commandCount == 0)
+			return;
+
+		m_uploadStream->copyRegionsToBuffer(
+			data.data(),
+			{ vk::BufferCopy{ 0, HEADER_SIZE + offset * getCommandSize(), commandCount * getCommandSize() } },
+			m_buffer
+		);
+	}
+
+	void IndirectDrawBuffer::setDrawCount(const uint32_t drawCount)
+	{
+		if (drawCount > m_commandCount)
+			throw std::runtime_error("Draw count exceeds the number of draw commands.");
+		if (drawCount == m_drawCount)
+			return;
+
+		m_uploadStream->copyRegionsToBuffer(
+			reinterpret_cast<const uint8_t*>(&drawCount),
+			{ vk::BufferCopy{ 0, 0, sizeof(drawCount) } },
+			m_buffer
+		);
+
+		if (!m_context->supportsDrawIndirectCount())
+			m_generation++;
+		m_drawCount = drawCount;
+	}
+
+	render::BufferStats IndirectDrawBuffer::getStats()
+	{
+		return render::BufferStats{
+			m_buffer->size(),
+			HEADER_SIZE + m_commandCount * getCommandSize(),
+			m_capacity.getReallocations(),
+			0
+		};
+	}
+
+	void IndirectDrawBuffer::record(const vk::CommandBuffer& cmd)
+	{
+		auto& buffer = m_buffer->buffer();
+		const auto stride = getCommandSize();
+
+		// With a count buffer, the draw count is read from the header when the draws execute
+		if (m_context->supportsDrawIndirectCount())
+		{
+			if (m_indexed)
+				cmd.drawIndexedIndirectCountKHR(buffer, HEADER_SIZE, buffer, 0, m_commandCount, stride);
+			else
+				cmd.drawIndirectCountKHR(buffer, HEADER_SIZE, buffer, 0, m_commandCount, stride);
+			return;
+		}
+
+		if (m_context->supportsMultiDrawIndirect())
+		{
+			if (m_indexed)
+				cmd.drawIndexedIndirect(buffer, HEADER_SIZE, m_drawCount, stride);
+			else
+				cmd.drawIndirect(buffer, HEADER_SIZE, m_drawCount, stride);
+			return;
+		}
+
+		for (auto i = 0u; i < m_drawCount; ++i)
+		{
+			if (m_indexed)
+				cmd.drawIndexedIndirect(buffer, HEADER_SIZE + i * stride, 1, stride);
+			else
+				cmd.drawIndirect(buffer, HEADER_SIZE + i * stride, 1, stride);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+﻿#pragma once
+#include "vk_buffer.h"
+#include "vk_buffer_capacity.h"
+#include "vk_context.h"
+#include "vk_upload_stream.h"
+#include "../../render/indirect_draw_buffer.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	// Draw commands live behind a header holding the draw count, in a single buffer that is updated in place
+	// through the upload stream. Recorded draws keep reading the same buffer, so only reallocating it or
+	// changing the counts they were recorded with requires recording them again.
+	class IndirectDrawBuffer final : public render::IndirectDrawBuffer
+	{
+	public:
+		IndirectDrawBuffer(
+			std::shared_ptr<VulkanContext> context,
+			std::shared_ptr<UploadStream> uploadStream,
+			bool indexed,
+			const std::vector<uint8_t>& data
+		);
+		~IndirectDrawBuffer() override;
+
+		[[nodiscard]] bool isIndexed() override
+		{
+			return m_indexed;
+		}
+
+		void write(const std::vector<uint8_t>& data) override;
+
+		void writeRange(uint32_t offset, const std::vector<uint8_t>& data) override;
+
+		void setDrawCount(uint32_t drawCount) override;
+
+		void setCapacityPolicy(const render::BufferCapacityPolicy& policy) override
+		{
+			m_capacity.setPolicy(policy);
+		}
+
+		[[nodiscard]] render::BufferStats getStats() override;
+
+		// Records the draws with whatever is currently bound.
+		void record(const vk::CommandBuffer& cmd);
+
+		// Changes whenever recorded draws go stale, so that they get recorded again
+		[[nodiscard]] uint64_t getGeneration() const
+		{
+			return m_generation;
+		}
+
+	private:
+		std::shared_ptr<VulkanContext> m_context;
+		std::shared_ptr<UploadStream> m_uploadStream;
+		std::shared_ptr<VulkanBuffer> m_buffer;
+		util::BufferCapacity m_capacity;
+		bool m_indexed;
+		uint32_t m_commandCount = 0;
+		uint32_t m_drawCount = 0;
+		uint64_t m_generation = 0;
+	};
+}
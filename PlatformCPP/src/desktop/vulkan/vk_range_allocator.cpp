@@ -0,0 +1,129 @@
+﻿#include "vk_range_allocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace digbuild::platform::desktop::vulkan::util
+{
+	RangeAllocator::RangeAllocator(const uint32_t size) :
+		m_size(size)
+	{
+		if (size > 0)
+			m_freeRanges.emplace(0, size);
+	}
+
+	std::optional<uint32_t> RangeAllocator::allocate(const uint32_t size, const uint32_t alignment)
+	{
+		if (size == 0)
+			return std::nullopt;
+
+		for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it)
+		{
+			const auto [rangeOffset, rangeSize] = *it;
+			const auto rangeEnd = rangeOffset + rangeSize;
+			const auto offset = alignUp(rangeOffset, alignment);
+			if (offset >= rangeEnd || rangeEnd - offset < size)
+				continue;
+
+			m_freeRanges.erase(it);
+			if (offset > rangeOffset)
+				m_freeRanges.emplace(rangeOffset, offset - rangeOffset);
+			if (offset + size < rangeEnd)
+				m_freeRanges.emplace(offset + size, rangeEnd - (offset + size));
+
+			m_used += size;
+			return offset;
+		}
+
+		return std::nullopt;
+	}
+
+	void RangeAllocator::free(uint32_t offset, uint32_t size)
+	{
+		if (size == 0)
+			return;
+		m_used -= size;
+
+		const auto next = m_freeRanges.lower_bound(offset);
+		if (next != m_freeRanges.end() && offset + size == next->first)
+		{
+			size += next->second;
+			m_freeRanges.erase(next);
+		}
+
+		auto it = m_freeRanges.lower_bound(offset);
+		if (it != m_freeRanges.begin())
+		{
+			const auto previous = std::prev(it);
+			if (previous->first + previous->second == offset)
+			{
+				previous->second += size;
+				return;
+			}
+		}
+
+		m_freeRanges.emplace(offset, size);
+	}
+
+	void RangeSet::add(uint32_t offset, const uint32_t size)
+	{
+		if (size == 0)
+			return;
+		auto end = offset + size;
+
+		auto it = m_ranges.upper_bound(offset);
+		if (it != m_ranges.begin())
+		{
+			const auto previous = std::prev(it);
+			if (previous->second >= offset)
+			{
+				offset = previous->first;
+				end = std::max(end, previous->second);
+				m_ranges.erase(previous);
+			}
+		}
+
+		while (it != m_ranges.end() && it->first <= end)
+		{
+			end = std::max(end, it->second);
+			it = m_ranges.erase(it);
+		}
+
+		m_ranges.emplace(offset, end);
+	}
+
+	void RangeSet::remove(const uint32_t offset, const uint32_t size)
+	{
+		if (size == 0)
+			return;
+		const auto end = offset + size;
+
+		auto it = m_ranges.upper_bound(offset);
+		if (it != m_ranges.begin())
+		{
+			const auto previous = std::prev(it);
+			const auto previousEnd = previous->second;
+			if (previousEnd > offset)
+			{
+				if (previous->first == offset)
+					m_ranges.erase(previous);
+				else
+					previous->second = offset;
+
+				if (previousEnd > end)
+					m_ranges.emplace(end, previousEnd);
+			}
+		}
+
+		while (it != m_ranges.end() && it->first < end)
+		{
+			const auto rangeEnd = it->second;
+			it = m_ranges.erase(it);
+			if (rangeEnd > end)
+			{
+				m_ranges.emplace(end, rangeEnd);
+				break;
+			}
+		}
+	}
+}
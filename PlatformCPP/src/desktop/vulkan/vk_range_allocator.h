@@ -0,0 +1,65 @@
+﻿#pragma once
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace digbuild::platform::desktop::vulkan::util
+{
+	class RangeAllocator final
+	{
+	public:
+		explicit RangeAllocator(uint32_t size);
+
+		[[nodiscard]] std::optional<uint32_t> allocate(uint32_t size, uint32_t alignment);
+		void free(uint32_t offset, uint32_t size);
+
+		[[nodiscard]] uint32_t size() const
+		{
+			return m_size;
+		}
+		[[nodiscard]] uint32_t used() const
+		{
+			return m_used;
+		}
+		[[nodiscard]] bool empty() const
+		{
+			return m_used == 0;
+		}
+
+	private:
+		// Free ranges, keyed by offset
+		std::map<uint32_t, uint32_t> m_freeRanges;
+		uint32_t m_size;
+		uint32_t m_used = 0;
+	};
+
+	// A set of ranges in which overlapping and adjacent ranges are merged
+	class RangeSet final
+	{
+	public:
+		void add(uint32_t offset, uint32_t size);
+		void remove(uint32_t offset, uint32_t size);
+
+		void clear()
+		{
+			m_ranges.clear();
+		}
+		[[nodiscard]] bool empty() const
+		{
+			return m_ranges.empty();
+		}
+		// Maps the start of every range to its end
+		[[nodiscard]] const std::map<uint32_t, uint32_t>& ranges() const
+		{
+			return m_ranges;
+		}
+
+	private:
+		std::map<uint32_t, uint32_t> m_ranges;
+	};
+
+	[[nodiscard]] constexpr uint32_t alignUp(const uint32_t value, const uint32_t alignment)
+	{
+		return alignment <= 1 ? value : (value + alignment - 1) / alignment * alignment;
+	}
+}
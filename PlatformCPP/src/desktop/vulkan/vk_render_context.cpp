@@ -1,6 +1,8 @@
 ﻿#include "vk_render_context.h"
 
 #include "vk_command_buffer.h"
+#include "vk_index_buffer.h"
+#include "vk_indirect_draw_buffer.h"
 #include "vk_render_pipeline.h"
 #include "vk_shader.h"
 #include "vk_texture_binding.h"
@@ -13,6 +15,10 @@
 namespace digbuild::platform::desktop::vulkan
 {
 	const vk::Fence NULL_FENCE = nullptr;
+	constexpr uint32_t UNIFORM_PAGE_SIZE = 1024 * 1024;
+	constexpr uint32_t GEOMETRY_PAGE_SIZE = 16 * 1024 * 1024;
+	constexpr uint32_t GEOMETRY_COMPACTION_BUDGET = 1024 * 1024;
+	constexpr uint32_t TRANSIENT_VERTEX_CHUNK_SIZE = 4 * 1024 * 1024;
 
 	void RenderQueue::clear()
 	{
@@ -29,9 +35,6 @@ namespace digbuild::platform::desktop::vulkan
 
 	void RenderQueue::write(vk::CommandBuffer& cmd)
 	{
-		cmd.begin(vk::CommandBufferBeginInfo{
-			vk::CommandBufferUsageFlagBits::eOneTimeSubmit
-		});
 		for (auto& [target, buffer] : m_queue)
 		{
 			auto& framebuffer = reinterpret_cast<Framebuffer&>(target->getFramebuffer());
@@ -68,7 +71,6 @@ namespace digbuild::platform::desktop::vulkan
 
 			framebuffer.advance();
 		}
-		cmd.end();
 	}
 
 	RenderContext::RenderContext(
@@ -82,7 +84,21 @@ namespace digbuild::platform::desktop::vulkan
 		m_swapChainStages(0),
 		m_maxFramesInFlight(0)
 	{
+		m_uniformAllocator = std::make_shared<UniformAllocator>(m_context, UNIFORM_PAGE_SIZE);
+		m_geometryArena = std::make_shared<GeometryArena>(m_context, GEOMETRY_PAGE_SIZE);
 		createSwapchain();
+
+		m_placeholderTexture = std::make_shared<StaticTexture>(
+			m_context,
+			m_uploadStream,
+			1, 1,
+			1, false,
+			render::TextureFormat::B8G8R8A8_SRGB,
+			std::vector<uint8_t>{ 0, 0, 0, 0 },
+			render::TextureMipmaps::NONE, 1,
+			nullptr,
+			nullptr
+		);
 	}
 
 	RenderContext::~RenderContext()
@@ -120,6 +136,15 @@ namespace digbuild::platform::desktop::vulkan
 		m_inFlightFence = m_context->createFence(m_maxFramesInFlight, true);
 		m_inFlightImages = std::vector(m_swapChainStages, NULL_FENCE);
 		// m_currentFrame = 0;
+
+		if (m_uploadStream)
+			m_uploadStream->reset(m_maxFramesInFlight);
+		else
+			m_uploadStream = std::make_shared<UploadStream>(m_context, m_maxFramesInFlight);
+		if (m_transientVertexAllocator)
+			m_transientVertexAllocator->reset(m_maxFramesInFlight);
+		else
+			m_transientVertexAllocator = std::make_shared<TransientVertexAllocator>(m_context, TRANSIENT_VERTEX_CHUNK_SIZE, m_maxFramesInFlight);
 		
 		auto renderPass = m_context->createSimpleRenderPass({
 			{ surfaceFormat.format, vk::ImageLayout::ePresentSrcKHR }
@@ -168,6 +193,9 @@ namespace digbuild::platform::desktop::vulkan
 	void RenderContext::updateFirst()
 	{
 		m_context->wait(m_inFlightFence[m_currentFrame]);
+		m_uploadStream->retire(m_currentFrame);
+		m_uploadStream->poll();
+		m_transientVertexAllocator->retire(m_currentFrame);
 
 		const auto acquireResult = m_context->acquireNextImage(*m_swapChain, m_imageAvailableSemaphore[m_currentFrame]);
 		if (acquireResult.result == vk::Result::eErrorOutOfDateKHR || m_surface.wasJustResized())
@@ -184,6 +212,7 @@ namespace digbuild::platform::desktop::vulkan
 
 	void RenderContext::updateLast()
 	{
+		m_geometryArena->compact(*m_uploadStream, GEOMETRY_COMPACTION_BUDGET);
 		visitTicking();
 		m_surface.resetResized();
 
@@ -194,11 +223,27 @@ namespace digbuild::platform::desktop::vulkan
 
 		auto& cb = m_commandBuffer[m_imageIndex];
 		auto& queue = m_renderQueues[m_imageIndex];
+		cb.begin(vk::CommandBufferBeginInfo{
+			vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+		});
+		const auto uploadSemaphore = m_uploadStream->record(cb, m_currentFrame);
 		queue.write(cb);
+		cb.end();
+		m_transientVertexAllocator->close(m_currentFrame);
+
+		m_uploadStream->submit();
 
+		std::vector<vk::Semaphore> waitSemaphores{ m_imageAvailableSemaphore[m_currentFrame] };
+		std::vector<vk::PipelineStageFlags> waitStages{ vk::PipelineStageFlagBits::eColorAttachmentOutput };
+		if (uploadSemaphore)
+		{
+			waitSemaphores.push_back(uploadSemaphore);
+			waitStages.push_back(UploadStream::getWaitStages());
+		}
 		m_context->submit(
 			cb,
-			m_imageAvailableSemaphore[m_currentFrame],
+			waitSemaphores,
+			waitStages,
 			m_renderFinishedSemaphore[m_currentFrame],
 			inFlight
 		);
@@ -233,6 +278,7 @@ namespace digbuild::platform::desktop::vulkan
 	{
 		return std::make_shared<Framebuffer>(
 			m_context,
+			m_uploadStream,
 			std::static_pointer_cast<FramebufferFormat>(format),
 			width, height,
 			m_swapChainStages
@@ -255,7 +301,8 @@ namespace digbuild::platform::desktop::vulkan
 		const render::VertexFormatDescriptor& vertexFormat,
 		const render::VertexFormatDescriptor& instanceFormat,
 		const render::RenderState state,
-		const std::vector<render::BlendOptions>& blendOptions
+		const std::vector<render::BlendOptions>& blendOptions,
+		const std::vector<render::PushConstantRange>& pushConstants
 	)
 	{
 		std::vector<std::shared_ptr<Shader>> vkShaders;
@@ -268,7 +315,8 @@ namespace digbuild::platform::desktop::vulkan
 			std::static_pointer_cast<FramebufferFormat>(format),
 			stage, vkShaders,
 			vertexFormat, instanceFormat,
-			state, blendOptions
+			state, blendOptions,
+			pushConstants
 		);
 	}
 
@@ -296,6 +344,8 @@ namespace digbuild::platform::desktop::vulkan
 	{
 		auto ub = std::make_shared<UniformBuffer>(
 			m_context,
+			m_uniformAllocator,
+			m_uploadStream,
 			m_swapChainStages,
 			initialData
 		);
@@ -313,6 +363,7 @@ namespace digbuild::platform::desktop::vulkan
 		{
 			auto vb = std::make_shared<DynamicVertexBuffer>(
 				m_context,
+				m_uploadStream,
 				initialData,
 				vertexSize,
 				m_swapChainStages
@@ -322,12 +373,43 @@ namespace digbuild::platform::desktop::vulkan
 		}
 
 		return std::make_shared<StaticVertexBuffer>(
-			m_context,
+			m_uploadStream,
+			m_geometryArena,
 			initialData,
 			vertexSize
 		);
 	}
 
+	std::shared_ptr<render::IndexBuffer> RenderContext::createIndexBuffer(
+		const std::vector<uint8_t>& initialData,
+		const render::IndexType indexType,
+		const bool writable
+	)
+	{
+		return std::make_shared<IndexBuffer>(
+			std::static_pointer_cast<VertexBuffer>(createVertexBuffer(
+				initialData,
+				render::getIndexSize(indexType),
+				writable
+			)),
+			indexType,
+			writable
+		);
+	}
+
+	std::shared_ptr<render::IndirectDrawBuffer> RenderContext::createIndirectDrawBuffer(
+		const std::vector<uint8_t>& initialData,
+		const bool indexed
+	)
+	{
+		return std::make_shared<IndirectDrawBuffer>(
+			m_context,
+			m_uploadStream,
+			indexed,
+			initialData
+		);
+	}
+
 	std::shared_ptr<render::TextureBinding> RenderContext::createTextureBinding(
 		const std::shared_ptr<render::Shader>& shader,
 		const uint32_t binding,
@@ -353,7 +435,11 @@ namespace digbuild::platform::desktop::vulkan
 		const render::TextureWrapping wrapping,
 		const render::TextureBorderColor borderColor,
 		const bool enableAnisotropy,
-		const uint32_t anisotropyLevel
+		const uint32_t anisotropyLevel,
+		const render::TextureMipmapMode mipmapMode,
+		const float minLod,
+		const float maxLod,
+		const float lodBias
 	)
 	{
 		return std::make_shared<TextureSampler>(
@@ -361,28 +447,101 @@ namespace digbuild::platform::desktop::vulkan
 			minFiltering, magFiltering,
 			wrapping,
 			borderColor,
-			enableAnisotropy, anisotropyLevel
+			enableAnisotropy, anisotropyLevel,
+			mipmapMode, minLod, maxLod, lodBias
 		);
 	}
 
 	std::shared_ptr<render::Texture> RenderContext::createTexture(
 		const uint32_t width, 
 		const uint32_t height,
-		const std::vector<uint8_t>& data
+		const render::TextureFormat format,
+		const std::vector<uint8_t>& data,
+		const render::TextureMipmaps mipmaps,
+		const uint32_t mipLevels
 	)
 	{
 		return std::make_shared<StaticTexture>(
 			m_context,
+			m_uploadStream,
 			width, height,
-			render::TextureFormat::B8G8R8A8_SRGB,
+			1, false,
+			format,
+			data,
+			mipmaps, mipLevels,
+			nullptr,
+			nullptr
+		);
+	}
+
+	std::shared_ptr<render::Texture> RenderContext::createTextureArray(
+		const uint32_t width,
+		const uint32_t height,
+		const uint32_t layers,
+		const render::TextureFormat format,
+		const std::vector<uint8_t>& data,
+		const render::TextureMipmaps mipmaps,
+		const uint32_t mipLevels
+	)
+	{
+		return std::make_shared<StaticTexture>(
+			m_context,
+			m_uploadStream,
+			width, height,
+			layers, true,
+			format,
+			data,
+			mipmaps, mipLevels,
+			nullptr,
+			nullptr
+		);
+	}
+
+	std::shared_ptr<render::Texture> RenderContext::createDynamicTexture(
+		const uint32_t width,
+		const uint32_t height,
+		const render::TextureFormat format,
+		const std::vector<uint8_t>& data
+	)
+	{
+		return std::make_shared<DynamicTexture>(
+			m_context,
+			m_uploadStream,
+			width, height,
+			format,
 			data
 		);
 	}
+
+	std::shared_ptr<render::Texture> RenderContext::createTextureAsync(
+		const uint32_t width,
+		const uint32_t height,
+		const render::TextureFormat format,
+		const std::vector<uint8_t>& data,
+		const render::TextureMipmaps mipmaps,
+		const uint32_t mipLevels,
+		std::function<void()> onReady
+	)
+	{
+		return std::make_shared<StaticTexture>(
+			m_context,
+			m_uploadStream,
+			width, height,
+			1, false,
+			format,
+			data,
+			mipmaps, mipLevels,
+			m_placeholderTexture,
+			std::move(onReady)
+		);
+	}
 	
 	std::shared_ptr<render::CommandBuffer> RenderContext::createCommandBuffer()
 	{
 		auto cmd = std::make_shared<CommandBuffer>(
 			m_context,
+			m_geometryArena,
+			m_transientVertexAllocator,
 			m_swapChainStages
 		);
 		addTicking(cmd);
@@ -400,6 +559,34 @@ namespace digbuild::platform::desktop::vulkan
 		);
 	}
 
+	bool RenderContext::isTextureFormatSupported(const render::TextureFormat format)
+	{
+		return m_context->supportsSampledFormat(util::toVulkanFormat(format));
+	}
+
+	bool RenderContext::isAttachmentFormatSupported(const render::TextureFormat format)
+	{
+		return m_context->supportsFormatFeatures(
+			util::toVulkanFormat(format),
+			util::getAttachmentFormatFeatures(format)
+		);
+	}
+
+	render::StagingStats RenderContext::getStagingStats()
+	{
+		return m_uploadStream->getStagingStats();
+	}
+
+	render::TransientVertices RenderContext::allocateTransientVertices(const uint32_t size, const uint32_t vertexSize)
+	{
+		return m_transientVertexAllocator->allocate(size, vertexSize);
+	}
+
+	render::StagingStats RenderContext::getTransientVertexStats()
+	{
+		return m_transientVertexAllocator->getStats();
+	}
+
 	void RenderContext::addTicking(std::weak_ptr<DynamicVertexBuffer> resource)
 	{
 		if (m_availableTickingVertexBufferSlots.empty())
@@ -5,9 +5,13 @@
 #include "vk_context.h"
 #include "vk_framebuffer.h"
 #include "vk_framebuffer_format.h"
+#include "vk_geometry_arena.h"
 #include "vk_texture_binding.h"
+#include "vk_transient_vertex_allocator.h"
+#include "vk_uniform_allocator.h"
 #include "vk_uniform_binding.h"
 #include "vk_uniform_buffer.h"
+#include "vk_upload_stream.h"
 #include "vk_vertex_buffer.h"
 #include "../dt_render_context.h"
 #include "../../render/render_surface.h"
@@ -74,7 +78,8 @@ namespace digbuild::platform::desktop::vulkan
 			const render::VertexFormatDescriptor& vertexFormat,
 			const render::VertexFormatDescriptor& instanceFormat,
 			render::RenderState state,
-			const std::vector<render::BlendOptions>& blendOptions
+			const std::vector<render::BlendOptions>& blendOptions,
+			const std::vector<render::PushConstantRange>& pushConstants
 		) override;
 
 		[[nodiscard]] std::shared_ptr<render::UniformBinding> createUniformBinding(
@@ -93,6 +98,17 @@ namespace digbuild::platform::desktop::vulkan
 			bool writable
 		) override;
 
+		[[nodiscard]] std::shared_ptr<render::IndexBuffer> createIndexBuffer(
+			const std::vector<uint8_t>& initialData,
+			render::IndexType indexType,
+			bool writable
+		) override;
+
+		[[nodiscard]] std::shared_ptr<render::IndirectDrawBuffer> createIndirectDrawBuffer(
+			const std::vector<uint8_t>& initialData,
+			bool indexed
+		) override;
+
 		[[nodiscard]] std::shared_ptr<render::TextureBinding> createTextureBinding(
 			const std::shared_ptr<render::Shader>& shader,
 			uint32_t binding,
@@ -106,14 +122,48 @@ namespace digbuild::platform::desktop::vulkan
 			render::TextureWrapping wrapping,
 			render::TextureBorderColor borderColor,
 			bool enableAnisotropy,
-			uint32_t anisotropyLevel
+			uint32_t anisotropyLevel,
+			render::TextureMipmapMode mipmapMode,
+			float minLod,
+			float maxLod,
+			float lodBias
 		) override;
 
 		[[nodiscard]] std::shared_ptr<render::Texture> createTexture(
 			uint32_t width,
 			uint32_t height,
+			render::TextureFormat format,
+			const std::vector<uint8_t>& data,
+			render::TextureMipmaps mipmaps,
+			uint32_t mipLevels
+		) override;
+
+		[[nodiscard]] std::shared_ptr<render::Texture> createTextureArray(
+			uint32_t width,
+			uint32_t height,
+			uint32_t layers,
+			render::TextureFormat format,
+			const std::vector<uint8_t>& data,
+			render::TextureMipmaps mipmaps,
+			uint32_t mipLevels
+		) override;
+
+		[[nodiscard]] std::shared_ptr<render::Texture> createDynamicTexture(
+			uint32_t width,
+			uint32_t height,
+			render::TextureFormat format,
 			const std::vector<uint8_t>& data
 		) override;
+
+		[[nodiscard]] std::shared_ptr<render::Texture> createTextureAsync(
+			uint32_t width,
+			uint32_t height,
+			render::TextureFormat format,
+			const std::vector<uint8_t>& data,
+			render::TextureMipmaps mipmaps,
+			uint32_t mipLevels,
+			std::function<void()> onReady
+		) override;
 		
 		[[nodiscard]] std::shared_ptr<render::CommandBuffer> createCommandBuffer(
 		) override;
@@ -123,6 +173,14 @@ namespace digbuild::platform::desktop::vulkan
 			const std::shared_ptr<render::CommandBuffer>& commandBuffer
 		) override;
 
+		[[nodiscard]] bool isTextureFormatSupported(render::TextureFormat format) override;
+		[[nodiscard]] bool isAttachmentFormatSupported(render::TextureFormat format) override;
+
+		[[nodiscard]] render::StagingStats getStagingStats() override;
+
+		[[nodiscard]] render::TransientVertices allocateTransientVertices(uint32_t size, uint32_t vertexSize) override;
+		[[nodiscard]] render::StagingStats getTransientVertexStats() override;
+
 		[[nodiscard]] render::Framebuffer& getFramebuffer() override
 		{
 			return *m_framebuffer;
@@ -146,6 +204,11 @@ namespace digbuild::platform::desktop::vulkan
 		std::shared_ptr<Framebuffer> m_framebuffer;
 		util::StagingResource<vk::CommandBuffer> m_commandBuffer;
 		std::vector<RenderQueue> m_renderQueues;
+		std::shared_ptr<UploadStream> m_uploadStream;
+		std::shared_ptr<TransientVertexAllocator> m_transientVertexAllocator;
+		std::shared_ptr<UniformAllocator> m_uniformAllocator;
+		std::shared_ptr<GeometryArena> m_geometryArena;
+		std::shared_ptr<Texture> m_placeholderTexture;
 		bool m_resized = false;
 
 		uint32_t m_maxFramesInFlight;
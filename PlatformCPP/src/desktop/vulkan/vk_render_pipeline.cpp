@@ -42,6 +42,18 @@ namespace digbuild::platform::desktop::vulkan
 			return vk::Format::eR32G32B32Sfloat;
 		case render::NumericType::FLOAT4:
 			return vk::Format::eR32G32B32A32Sfloat;
+		case render::NumericType::HALF2:
+			return vk::Format::eR16G16Sfloat;
+		case render::NumericType::HALF4:
+			return vk::Format::eR16G16B16A16Sfloat;
+		case render::NumericType::SNORM8X4:
+			return vk::Format::eR8G8B8A8Snorm;
+		case render::NumericType::UNORM8X4:
+			return vk::Format::eR8G8B8A8Unorm;
+		case render::NumericType::UNORM16X2:
+			return vk::Format::eR16G16Unorm;
+		case render::NumericType::A2B10G10R10:
+			return vk::Format::eA2B10G10R10UnormPack32;
 		default:
 			throw std::runtime_error("Unsupported type.");
 		}
@@ -269,6 +281,25 @@ namespace digbuild::platform::desktop::vulkan
 		};
 	}
 
+	vk::ShaderStageFlags toVulkan(const render::ShaderStages stages)
+	{
+		vk::ShaderStageFlags flags = {};
+		if (static_cast<uint8_t>(stages & render::ShaderStages::VERTEX))
+			flags |= vk::ShaderStageFlagBits::eVertex;
+		if (static_cast<uint8_t>(stages & render::ShaderStages::FRAGMENT))
+			flags |= vk::ShaderStageFlagBits::eFragment;
+		return flags;
+	}
+
+	vk::PushConstantRange toVulkan(const render::PushConstantRange range)
+	{
+		if (range.offset % 4 != 0 || range.size % 4 != 0 || range.size == 0)
+			throw std::runtime_error("Push constant ranges must be non-empty and aligned to 4 bytes.");
+		if (range.offset + range.size > render::MAX_PUSH_CONSTANTS_SIZE)
+			throw std::runtime_error("Push constant range exceeds the maximum push constant size.");
+		return vk::PushConstantRange{ toVulkan(range.stages), range.offset, range.size };
+	}
+
 	std::vector<vk::DynamicState> toVulkan(const render::RenderState state)
 	{
 		std::vector<vk::DynamicState> dynamicStates;
@@ -305,7 +336,8 @@ namespace digbuild::platform::desktop::vulkan
 		const render::VertexFormatDescriptor& vertexFormat,
 		const render::VertexFormatDescriptor& instanceFormat,
 		const render::RenderState state,
-		const std::vector<render::BlendOptions>& blendOptions
+		const std::vector<render::BlendOptions>& blendOptions,
+		const std::vector<render::PushConstantRange>& pushConstants
 	) :
 		m_context(std::move(context)),
 		m_format(std::move(format)),
@@ -325,6 +357,14 @@ namespace digbuild::platform::desktop::vulkan
 			vertexAttributes.insert(vertexAttributes.end(), perInstanceAttributes.begin(), perInstanceAttributes.end());
 		}
 
+		// Not every packed type is guaranteed to be readable from vertex buffers
+		for (const auto& attribute : vertexAttributes)
+		{
+			const auto features = m_context->getFormatProperties(attribute.format).bufferFeatures;
+			if (!(features & vk::FormatFeatureFlagBits::eVertexBuffer))
+				throw std::runtime_error("Vertex attribute type is not supported by the device.");
+		}
+
 		vk::PipelineVertexInputStateCreateInfo vertexInputStateCreateInfo{ {}, vertexBindings, vertexAttributes };
 		vk::PipelineInputAssemblyStateCreateInfo inputAssemblyStateCreateInfo{ {}, toVulkan(state.topology), false };
 
@@ -389,9 +429,12 @@ namespace digbuild::platform::desktop::vulkan
 			m_shaderLayoutOffsets.emplace(shader.get(), descriptorOffset);
 			descriptorOffset += static_cast<uint32_t>(layouts.size());
 		}
-		m_layout = m_context->m_device->createPipelineLayoutUnique({ {}, m_descriptorSetLayouts });
 
-		// TODO: Other layout / uniform stuff
+		m_pushConstantRanges.reserve(pushConstants.size());
+		for (const auto& range : pushConstants)
+			m_pushConstantRanges.push_back(toVulkan(range));
+
+		m_layout = m_context->m_device->createPipelineLayoutUnique({ {}, m_descriptorSetLayouts, m_pushConstantRanges });
 
 		std::vector<vk::PipelineShaderStageCreateInfo> pipelineShaderStageCreateInfos;
 		for (const auto& shader : m_shaders)
@@ -416,4 +459,33 @@ namespace digbuild::platform::desktop::vulkan
 			-1
 		}).value;
 	}
+
+	vk::ShaderStageFlags RenderPipeline::getPushConstantStages(const uint32_t offset, const uint32_t size) const
+	{
+		if (offset % 4 != 0 || size % 4 != 0 || size == 0)
+			throw std::runtime_error("Push constant updates must be non-empty and aligned to 4 bytes.");
+
+		// Every range overlapping the update must be updated in full for all of its stages,
+		// so each byte has to be covered by the same set of stages
+		vk::ShaderStageFlags stages = {};
+		for (const auto& range : m_pushConstantRanges)
+		{
+			if (range.offset < offset + size && offset < range.offset + range.size)
+				stages |= range.stageFlags;
+		}
+
+		for (auto byte = offset; byte < offset + size; byte += 4)
+		{
+			vk::ShaderStageFlags covered = {};
+			for (const auto& range : m_pushConstantRanges)
+			{
+				if (range.offset <= byte && byte < range.offset + range.size)
+					covered |= range.stageFlags;
+			}
+			if (covered != stages || !covered)
+				throw std::runtime_error("Push constant update is not covered by the pipeline's push constant ranges.");
+		}
+
+		return stages;
+	}
 }
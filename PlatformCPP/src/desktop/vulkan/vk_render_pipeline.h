@@ -18,7 +18,8 @@ namespace digbuild::platform::desktop::vulkan
 			const render::VertexFormatDescriptor& vertexFormat,
 			const render::VertexFormatDescriptor& instanceFormat,
 			render::RenderState state,
-			const std::vector<render::BlendOptions>& blendOptions
+			const std::vector<render::BlendOptions>& blendOptions,
+			const std::vector<render::PushConstantRange>& pushConstants
 		);
 
 		[[nodiscard]] vk::Pipeline& get()
@@ -35,6 +36,9 @@ namespace digbuild::platform::desktop::vulkan
 		{
 			return m_shaderLayoutOffsets.at(shader.get());
 		}
+
+		// Returns the stages to update the given bytes of push constant data for.
+		[[nodiscard]] vk::ShaderStageFlags getPushConstantStages(uint32_t offset, uint32_t size) const;
 	
 	private:
 		std::shared_ptr<VulkanContext> m_context;
@@ -42,6 +46,7 @@ namespace digbuild::platform::desktop::vulkan
 		std::vector<std::shared_ptr<Shader>> m_shaders;
 		std::unordered_map<Shader*, uint32_t> m_shaderLayoutOffsets;
 		std::vector<vk::DescriptorSetLayout> m_descriptorSetLayouts;
+		std::vector<vk::PushConstantRange> m_pushConstantRanges;
 		vk::UniquePipelineLayout m_layout;
 		vk::UniquePipeline m_pipeline;
 	};
@@ -0,0 +1,138 @@
+﻿#include "vk_staging_belt.h"
+
+#include <algorithm>
+
+#include "vk_range_allocator.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	// Satisfies the offset requirements of buffer to image copies for every format we support
+	constexpr uint32_t STAGING_ALIGNMENT = 16;
+
+	StagingBelt::StagingBelt(
+		std::shared_ptr<VulkanContext> context,
+		const uint32_t chunkSize,
+		const uint32_t frames,
+		const vk::BufferUsageFlags usage,
+		const bool preferDirect
+	) :
+		m_context(std::move(context)),
+		m_chunkSize(chunkSize),
+		m_usage(usage),
+		m_preferDirect(preferDirect)
+	{
+		m_frames.resize(frames);
+	}
+
+	StagingAllocation StagingBelt::allocate(const uint32_t size)
+	{
+		m_pending.usedBytes += size;
+		m_usedBytes += size;
+		m_peakUsedBytes = std::max(m_peakUsedBytes, m_usedBytes);
+
+		// Allocations that would not fit in a regular chunk get one of their own, which is released on retirement
+		if (size > m_chunkSize)
+		{
+			auto& chunk = m_pending.chunks.emplace_back(
+				m_context->createMappedBuffer(size, m_usage)
+			);
+			m_dedicatedChunkCount++;
+			const auto index = static_cast<uint32_t>(m_pending.chunks.size() - 1);
+			return StagingAllocation{ chunk.get(), index, 0, chunk->mappedMemory() };
+		}
+
+		const auto offset = util::alignUp(m_openOffset, STAGING_ALIGNMENT);
+		if (!m_openChunk || offset + size > m_chunkSize)
+		{
+			std::unique_ptr<VulkanBuffer> chunk;
+			if (!m_freeChunks.empty())
+			{
+				chunk = std::move(m_freeChunks.back());
+				m_freeChunks.pop_back();
+			}
+			else
+			{
+				// Regular chunks are kept for the lifetime of the belt, so only they are worth placing in device memory
+				if (m_preferDirect)
+					chunk = m_context->createDirectBuffer(m_chunkSize, m_usage);
+				if (chunk)
+					m_directChunkCount++;
+				else
+					chunk = m_context->createMappedBuffer(m_chunkSize, m_usage);
+				m_chunkCount++;
+			}
+
+			m_openChunk = m_pending.chunks.emplace_back(std::move(chunk)).get();
+			m_openIndex = static_cast<uint32_t>(m_pending.chunks.size() - 1);
+			m_openOffset = size;
+			return StagingAllocation{ m_openChunk, m_openIndex, 0, m_openChunk->mappedMemory() };
+		}
+
+		m_openOffset = offset + size;
+		return StagingAllocation{ m_openChunk, m_openIndex, offset, m_openChunk->mappedMemory() + offset };
+	}
+
+	VulkanBuffer* StagingBelt::getOpenChunk(const uint32_t chunk) const
+	{
+		if (chunk >= m_pending.chunks.size())
+			return nullptr;
+		return m_pending.chunks[chunk].get();
+	}
+
+	void StagingBelt::close(const uint32_t frame)
+	{
+		m_openChunk = nullptr;
+		m_openOffset = 0;
+
+		auto& target = m_frames[frame];
+		target.chunks.insert(
+			target.chunks.end(),
+			std::make_move_iterator(m_pending.chunks.begin()),
+			std::make_move_iterator(m_pending.chunks.end())
+		);
+		target.usedBytes += m_pending.usedBytes;
+		m_pending = {};
+	}
+
+	void StagingBelt::retire(const uint32_t frame)
+	{
+		recycle(m_frames[frame]);
+	}
+
+	void StagingBelt::reset(const uint32_t frames)
+	{
+		for (auto& frame : m_frames)
+			recycle(frame);
+		m_frames.clear();
+		m_frames.resize(frames);
+	}
+
+	render::StagingStats StagingBelt::getStats() const
+	{
+		return render::StagingStats{
+			static_cast<uint64_t>(m_chunkCount) * m_chunkSize,
+			m_usedBytes,
+			m_peakUsedBytes,
+			m_chunkCount,
+			m_dedicatedChunkCount,
+			m_directChunkCount
+		};
+	}
+
+	void StagingBelt::recycle(Frame& frame)
+	{
+		for (auto& chunk : frame.chunks)
+		{
+			if (chunk->size() == m_chunkSize)
+			{
+				m_freeChunks.push_back(std::move(chunk));
+				continue;
+			}
+			m_dedicatedChunkCount--;
+		}
+		frame.chunks.clear();
+
+		m_usedBytes -= frame.usedBytes;
+		frame.usedBytes = 0;
+	}
+}
@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <memory>
+#include <vector>
+#include <vulkan.h>
+
+#include "vk_buffer.h"
+#include "vk_context.h"
+#include "../../render/render_context.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	struct StagingAllocation
+	{
+		VulkanBuffer* buffer;
+		// Index of the buffer among the chunks allocated from since the last close
+		uint32_t chunk;
+		uint32_t offset;
+		uint8_t* data;
+	};
+
+	// Hands out host-visible memory from a set of persistently mapped chunks, which are recycled
+	// once the frame that consumed them has finished executing. Not thread-safe, access is guarded by the owner.
+	class StagingBelt final
+	{
+	public:
+		StagingBelt(
+			std::shared_ptr<VulkanContext> context,
+			uint32_t chunkSize,
+			uint32_t frames,
+			vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eTransferSrc,
+			bool preferDirect = false
+		);
+		~StagingBelt() = default;
+		StagingBelt(const StagingBelt& other) = delete;
+		StagingBelt(StagingBelt&& other) noexcept = delete;
+		StagingBelt& operator=(const StagingBelt& other) = delete;
+		StagingBelt& operator=(StagingBelt&& other) noexcept = delete;
+
+		[[nodiscard]] StagingAllocation allocate(uint32_t size);
+		// Returns a chunk allocated from since the last close, or null if there is no such chunk
+		[[nodiscard]] VulkanBuffer* getOpenChunk(uint32_t chunk) const;
+
+		// Hands every chunk allocated from since the last call over to the frame.
+		void close(uint32_t frame);
+		// Recycles the chunks used by the frame. Must only be called once its fence has signaled.
+		void retire(uint32_t frame);
+		// Recycles all frames and resizes. Must only be called while the device is idle.
+		void reset(uint32_t frames);
+
+		[[nodiscard]] render::StagingStats getStats() const;
+
+	private:
+		struct Frame
+		{
+			std::vector<std::unique_ptr<VulkanBuffer>> chunks;
+			uint64_t usedBytes = 0;
+		};
+
+		void recycle(Frame& frame);
+
+		std::shared_ptr<VulkanContext> m_context;
+		const uint32_t m_chunkSize;
+		const vk::BufferUsageFlags m_usage;
+		const bool m_preferDirect;
+
+		// Every chunk allocated from is added to the pending frame straight away, including the one still open
+		Frame m_pending;
+		VulkanBuffer* m_openChunk = nullptr;
+		uint32_t m_openIndex = 0;
+		uint32_t m_openOffset = 0;
+		std::vector<Frame> m_frames;
+		std::vector<std::unique_ptr<VulkanBuffer>> m_freeChunks;
+
+		uint32_t m_chunkCount = 0;
+		uint32_t m_dedicatedChunkCount = 0;
+		uint32_t m_directChunkCount = 0;
+		uint64_t m_usedBytes = 0;
+		uint64_t m_peakUsedBytes = 0;
+	};
+}
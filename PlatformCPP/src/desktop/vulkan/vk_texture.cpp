@@ -1,51 +1,264 @@
 ﻿#include "vk_texture.h"
 
+#include <algorithm>
+
 namespace digbuild::platform::desktop::vulkan
 {
+	void Texture::writeImageRegion(
+		UploadStream& uploadStream,
+		const std::shared_ptr<VulkanImage>& image,
+		const render::TextureFormat format,
+		const uint32_t x, const uint32_t y,
+		const uint32_t width, const uint32_t height,
+		const uint32_t layer, const uint32_t mipLevel,
+		const std::vector<uint8_t>& data
+	)
+	{
+		if (layer >= getLayers())
+			throw std::runtime_error("Layer exceeds the layer count of the texture.");
+		if (mipLevel >= getMipLevels())
+			throw std::runtime_error("Mip level exceeds the mip level count of the texture.");
+
+		const auto levelWidth = std::max(getWidth() >> mipLevel, 1u);
+		const auto levelHeight = std::max(getHeight() >> mipLevel, 1u);
+		if (width == 0 || height == 0 || x + width > levelWidth || y + height > levelHeight)
+			throw std::runtime_error("Region exceeds the size of the texture.");
+
+		// Regions of block compressed images cover whole blocks, except where they reach the edge of the image
+		const auto blockExtent = render::getBlockExtent(format);
+		if (x % blockExtent != 0 || y % blockExtent != 0 ||
+			(width % blockExtent != 0 && x + width != levelWidth) ||
+			(height % blockExtent != 0 && y + height != levelHeight))
+			throw std::runtime_error("Region is not aligned to the texel blocks of the texture.");
+
+		if (data.size() != render::getImageSize(format, width, height))
+			throw std::runtime_error("Texture data does not match the size of the region.");
+
+		uploadStream.copyToImageRegion(
+			data.data(), static_cast<uint32_t>(data.size()),
+			image,
+			vk::ImageAspectFlagBits::eColor,
+			vk::ImageLayout::eShaderReadOnlyOptimal,
+			vk::ImageSubresourceLayers{ vk::ImageAspectFlagBits::eColor, mipLevel, layer, 1 },
+			vk::Offset3D{ static_cast<int32_t>(x), static_cast<int32_t>(y), 0 },
+			vk::Extent3D{ width, height, 1 }
+		);
+	}
+
 	StaticTexture::StaticTexture(
 		std::shared_ptr<VulkanContext> context,
+		std::shared_ptr<UploadStream> uploadStream,
+		const uint32_t width, const uint32_t height,
+		const uint32_t layers, const bool array,
+		const render::TextureFormat format,
+		const std::vector<uint8_t>& data,
+		const render::TextureMipmaps mipmaps,
+		const uint32_t mipLevels,
+		std::shared_ptr<Texture> placeholder,
+		std::function<void()> onReady
+	) :
+		m_context(std::move(context)),
+		m_uploadStream(std::move(uploadStream)),
+		m_format(format),
+		m_width(width),
+		m_height(height),
+		m_layers(layers),
+		m_mipLevels(1),
+		m_placeholder(std::move(placeholder)),
+		m_ready(std::make_shared<std::atomic_bool>(m_placeholder == nullptr))
+	{
+		if (layers == 0)
+			throw std::runtime_error("Textures must have at least one layer.");
+		if (layers > 1 && !array)
+			throw std::runtime_error("Only texture arrays can have more than one layer.");
+
+		const auto fmt = util::toVulkanFormat(format);
+		if (!m_context->supportsSampledFormat(fmt))
+			throw std::runtime_error("Texture format is not supported by the device.");
+
+		if (mipmaps != render::TextureMipmaps::NONE)
+		{
+			const auto fullMipLevels = render::getFullMipLevels(width, height);
+			if (mipLevels > fullMipLevels)
+				throw std::runtime_error("Mip level count exceeds the size of the texture.");
+			m_mipLevels = mipLevels == render::FULL_MIP_CHAIN ? fullMipLevels : mipLevels;
+		}
+
+		// Layers are packed back to back in the data, each one followed by its precomputed levels if there are any
+		const auto copiedLevels = mipmaps == render::TextureMipmaps::PRECOMPUTED ? m_mipLevels : 1;
+		std::vector<vk::BufferImageCopy> regions;
+		regions.reserve(layers * copiedLevels);
+		uint32_t dataSize = 0;
+		for (auto layer = 0u; layer < layers; ++layer)
+		{
+			for (auto level = 0u; level < copiedLevels; ++level)
+			{
+				const auto levelWidth = std::max(width >> level, 1u);
+				const auto levelHeight = std::max(height >> level, 1u);
+				regions.emplace_back(
+					dataSize, 0, 0,
+					vk::ImageSubresourceLayers{ vk::ImageAspectFlagBits::eColor, level, layer, 1 },
+					vk::Offset3D{ 0, 0, 0 },
+					vk::Extent3D{ levelWidth, levelHeight, 1 }
+				);
+				dataSize += render::getImageSize(format, levelWidth, levelHeight);
+			}
+		}
+		if (data.size() != dataSize)
+			throw std::runtime_error("Texture data does not match the size of the texture.");
+
+		std::optional<MipGeneration> mipGeneration;
+		auto usageFlags = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst;
+		if (mipmaps == render::TextureMipmaps::GENERATE && m_mipLevels > 1)
+		{
+			const auto features = m_context->getFormatProperties(fmt).optimalTilingFeatures;
+			if (!(features & vk::FormatFeatureFlagBits::eBlitSrc) || !(features & vk::FormatFeatureFlagBits::eBlitDst))
+				throw std::runtime_error("Texture format does not support mipmap generation.");
+
+			mipGeneration = MipGeneration{
+				width, height,
+				m_mipLevels, layers,
+				features & vk::FormatFeatureFlagBits::eSampledImageFilterLinear ? vk::Filter::eLinear : vk::Filter::eNearest
+			};
+			usageFlags |= vk::ImageUsageFlagBits::eTransferSrc;
+		}
+
+		m_image = m_context->createImage(
+			width, height,
+			m_mipLevels, layers,
+			fmt,
+			usageFlags,
+			vk::MemoryPropertyFlagBits::eDeviceLocal
+		);
+		m_imageView = m_context->createImageView(
+			m_image->get(),
+			array ? vk::ImageViewType::e2DArray : vk::ImageViewType::e2D,
+			fmt,
+			vk::ImageAspectFlagBits::eColor,
+			m_mipLevels, layers
+		);
+		
+		auto copy = [image = m_image.get(), regions = std::move(regions)](const vk::CommandBuffer& cmd, const vk::Buffer& src, const uint32_t srcOffset)
+		{
+			auto stagedRegions = regions;
+			for (auto& region : stagedRegions)
+				region.bufferOffset += srcOffset;
+			cmd.copyBufferToImage(src, image->get(), vk::ImageLayout::eTransferDstOptimal, stagedRegions);
+		};
+		const ImageUpload upload{
+			m_image->get(),
+			vk::ImageAspectFlagBits::eColor,
+			vk::ImageLayout::eShaderReadOnlyOptimal,
+			mipGeneration
+		};
+
+		// Without a placeholder, the upload is recorded ahead of the first frame that could sample it
+		if (!m_placeholder)
+		{
+			m_uploadStream->copyToImage(
+				data.data(), static_cast<uint32_t>(data.size()),
+				std::move(copy),
+				{ m_image },
+				upload
+			);
+			return;
+		}
+
+		m_uploadStream->copyToImageAsync(
+			data.data(), static_cast<uint32_t>(data.size()),
+			std::move(copy),
+			{ m_image },
+			upload,
+			[ready = m_ready, onReady = std::move(onReady)]()
+			{
+				*ready = true;
+				if (onReady)
+					onReady();
+			}
+		);
+	}
+
+	void StaticTexture::writeRegion(
+		const uint32_t x, const uint32_t y,
+		const uint32_t width, const uint32_t height,
+		const uint32_t layer, const uint32_t mipLevel,
+		const std::vector<uint8_t>& data
+	)
+	{
+		// The write would be ordered before the asynchronous upload completes, and be lost to it
+		if (!*m_ready)
+			throw std::runtime_error("Cannot write to a texture before it has finished uploading.");
+
+		writeImageRegion(*m_uploadStream, m_image, m_format, x, y, width, height, layer, mipLevel, data);
+	}
+
+	DynamicTexture::DynamicTexture(
+		std::shared_ptr<VulkanContext> context,
+		std::shared_ptr<UploadStream> uploadStream,
 		const uint32_t width, const uint32_t height,
 		const render::TextureFormat format,
 		const std::vector<uint8_t>& data
 	) :
 		m_context(std::move(context)),
+		m_uploadStream(std::move(uploadStream)),
+		m_format(format),
 		m_width(width),
 		m_height(height)
 	{
 		const auto fmt = util::toVulkanFormat(format);
+		if (!m_context->supportsSampledFormat(fmt))
+			throw std::runtime_error("Texture format is not supported by the device.");
+		const auto size = render::getImageSize(format, width, height);
+		if (!data.empty() && data.size() != size)
+			throw std::runtime_error("Texture data does not match the size of the texture.");
+
+		// A single image is shared by all frames. Writes are recorded on the graphics queue, ordered
+		// after the reads of earlier frames, so bindings never have to switch to another view.
 		m_image = m_context->createImage(
 			width, height,
+			1, 1,
 			fmt,
 			vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst,
 			vk::MemoryPropertyFlagBits::eDeviceLocal
 		);
-		m_imageView = m_context->createImageView(m_image->get(), fmt, vk::ImageAspectFlagBits::eColor);
-		
-		auto buf = m_context->createCpuToGpuTransferBuffer(
-			data.data(),
-			static_cast<uint32_t>(data.size())
+		m_imageView = m_context->createImageView(
+			m_image->get(),
+			vk::ImageViewType::e2D,
+			fmt,
+			vk::ImageAspectFlagBits::eColor,
+			1, 1
 		);
 
-		util::directExecuteCommands(
-			*m_context->m_device,
-			*m_context->m_commandPool,
-			m_context->m_graphicsQueue,
-			[&](vk::CommandBuffer& cmd)
+		// The image must be initialized before it can be sampled, so missing data is uploaded as zeroes
+		const auto initialData = data.empty() ? std::vector<uint8_t>(size) : data;
+		m_uploadStream->copyToImage(
+			initialData.data(), size,
+			[image = m_image.get(), width, height](const vk::CommandBuffer& cmd, const vk::Buffer& src, const uint32_t srcOffset)
 			{
-				util::transitionImageLayouts(cmd, {{
-					m_image->get(),
-					vk::ImageAspectFlagBits::eColor,
-					vk::ImageLayout::eUndefined,
-					vk::ImageLayout::eTransferDstOptimal
-				}});
-				util::copyBufferToImage(cmd, buf->buffer(), m_image->get(), width, height);
-				util::transitionImageLayouts(cmd, {{
-					m_image->get(),
-					vk::ImageAspectFlagBits::eColor,
-					vk::ImageLayout::eTransferDstOptimal,
-					vk::ImageLayout::eShaderReadOnlyOptimal
-				}});
+				util::copyBufferToImage(cmd, src, srcOffset, image->get(), width, height);
+			},
+			{ m_image },
+			ImageUpload{
+				m_image->get(),
+				vk::ImageAspectFlagBits::eColor,
+				vk::ImageLayout::eShaderReadOnlyOptimal
 			}
 		);
 	}
-}
+
+	void DynamicTexture::write(const std::vector<uint8_t>& data)
+	{
+		// A full write replaces any earlier writes of the same frame, so only the last one gets uploaded
+		writeImageRegion(*m_uploadStream, m_image, m_format, 0, 0, m_width, m_height, 0, 0, data);
+	}
+
+	void DynamicTexture::writeRegion(
+		const uint32_t x, const uint32_t y,
+		const uint32_t width, const uint32_t height,
+		const uint32_t layer, const uint32_t mipLevel,
+		const std::vector<uint8_t>& data
+	)
+	{
+		writeImageRegion(*m_uploadStream, m_image, m_format, x, y, width, height, layer, mipLevel, data);
+	}
+}
\ No newline at end of file
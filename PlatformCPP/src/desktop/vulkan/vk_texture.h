@@ -1,5 +1,9 @@
 ﻿#pragma once
+#include <atomic>
+#include <functional>
+
 #include "vk_context.h"
+#include "vk_upload_stream.h"
 #include "vk_util.h"
 #include "../../render/texture.h"
 
@@ -9,6 +13,18 @@ namespace digbuild::platform::desktop::vulkan
 	{
 	public:
 		virtual vk::ImageView& get() = 0;
+
+	protected:
+		// Validates the region against the texture's dimensions and queues the data to be copied into it
+		void writeImageRegion(
+			UploadStream& uploadStream,
+			const std::shared_ptr<VulkanImage>& image,
+			render::TextureFormat format,
+			uint32_t x, uint32_t y,
+			uint32_t width, uint32_t height,
+			uint32_t layer, uint32_t mipLevel,
+			const std::vector<uint8_t>& data
+		);
 	};
 
 	class StaticTexture : public Texture
@@ -16,9 +32,15 @@ namespace digbuild::platform::desktop::vulkan
 	public:
 		StaticTexture(
 			std::shared_ptr<VulkanContext> context,
+			std::shared_ptr<UploadStream> uploadStream,
 			const uint32_t width, const uint32_t height,
+			const uint32_t layers, const bool array,
 			const render::TextureFormat format,
-			const std::vector<uint8_t>& data
+			const std::vector<uint8_t>& data,
+			render::TextureMipmaps mipmaps,
+			uint32_t mipLevels,
+			std::shared_ptr<Texture> placeholder,
+			std::function<void()> onReady
 		);
 
 		[[nodiscard]] uint32_t getWidth() override
@@ -29,7 +51,94 @@ namespace digbuild::platform::desktop::vulkan
 		{
 			return m_height;
 		}
+		[[nodiscard]] uint32_t getLayers() override
+		{
+			return m_layers;
+		}
+		[[nodiscard]] uint32_t getMipLevels() override
+		{
+			return m_mipLevels;
+		}
+
+		[[nodiscard]] bool isReady() override
+		{
+			return *m_ready;
+		}
+
+		void write(const std::vector<uint8_t>& data) override
+		{
+			throw std::runtime_error("Cannot write to a static texture.");
+		}
+
+		void writeRegion(
+			uint32_t x, uint32_t y,
+			uint32_t width, uint32_t height,
+			uint32_t layer, uint32_t mipLevel,
+			const std::vector<uint8_t>& data
+		) override;
 		
+		[[nodiscard]] vk::ImageView& get() override
+		{
+			if (!*m_ready)
+				return m_placeholder->get();
+			return *m_imageView;
+		}
+
+	private:
+		std::shared_ptr<VulkanContext> m_context;
+		std::shared_ptr<UploadStream> m_uploadStream;
+		render::TextureFormat m_format;
+		uint32_t m_width, m_height;
+		uint32_t m_layers;
+		uint32_t m_mipLevels;
+		std::shared_ptr<VulkanImage> m_image;
+		vk::UniqueImageView m_imageView;
+		std::shared_ptr<Texture> m_placeholder;
+		std::shared_ptr<std::atomic_bool> m_ready;
+	};
+
+	class DynamicTexture final : public Texture
+	{
+	public:
+		DynamicTexture(
+			std::shared_ptr<VulkanContext> context,
+			std::shared_ptr<UploadStream> uploadStream,
+			uint32_t width, uint32_t height,
+			render::TextureFormat format,
+			const std::vector<uint8_t>& data
+		);
+
+		[[nodiscard]] uint32_t getWidth() override
+		{
+			return m_width;
+		}
+		[[nodiscard]] uint32_t getHeight() override
+		{
+			return m_height;
+		}
+		[[nodiscard]] uint32_t getLayers() override
+		{
+			return 1;
+		}
+		[[nodiscard]] uint32_t getMipLevels() override
+		{
+			return 1;
+		}
+
+		[[nodiscard]] bool isReady() override
+		{
+			return true;
+		}
+
+		void write(const std::vector<uint8_t>& data) override;
+
+		void writeRegion(
+			uint32_t x, uint32_t y,
+			uint32_t width, uint32_t height,
+			uint32_t layer, uint32_t mipLevel,
+			const std::vector<uint8_t>& data
+		) override;
+
 		[[nodiscard]] vk::ImageView& get() override
 		{
 			return *m_imageView;
@@ -37,8 +146,10 @@ namespace digbuild::platform::desktop::vulkan
 
 	private:
 		std::shared_ptr<VulkanContext> m_context;
+		std::shared_ptr<UploadStream> m_uploadStream;
+		render::TextureFormat m_format;
 		uint32_t m_width, m_height;
-		std::unique_ptr<VulkanImage> m_image;
+		std::shared_ptr<VulkanImage> m_image;
 		vk::UniqueImageView m_imageView;
 	};
 }
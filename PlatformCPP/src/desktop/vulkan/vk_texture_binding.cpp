@@ -16,6 +16,7 @@ namespace digbuild::platform::desktop::vulkan
 	{
 		m_samplers.resize(stages);
 		m_textures.resize(stages);
+		m_views.resize(stages);
 		
 		m_descriptorPool = m_context->createDescriptorPool(stages, vk::DescriptorType::eCombinedImageSampler);
 		m_descriptorSets = m_context->createDescriptorSets(
@@ -32,15 +33,20 @@ namespace digbuild::platform::desktop::vulkan
 	{
 		const auto writeIndex = (m_readIndex + 1) % static_cast<uint32_t>(m_descriptorSets.size());
 
-		if (m_leftoverWrites == 0)
+		// Textures may swap the view they expose, such as once an asynchronous upload completes
+		const auto& texture = m_textures[writeIndex];
+		const auto outdated = texture && texture->get() != m_views[writeIndex];
+
+		if (m_leftoverWrites == 0 && !outdated)
 		{
 			m_readIndex = writeIndex;
 			return;
 		}
 
+		m_views[writeIndex] = texture->get();
 		const vk::DescriptorImageInfo imageInfo{
 			m_samplers[writeIndex]->get(),
-			m_textures[writeIndex]->get(),
+			m_views[writeIndex],
 			vk::ImageLayout::eShaderReadOnlyOptimal
 		};
 		const vk::WriteDescriptorSet write{
@@ -60,7 +66,8 @@ namespace digbuild::platform::desktop::vulkan
 		m_samplers[nextWriteIndex] = m_samplers[writeIndex];
 		m_textures[nextWriteIndex] = m_textures[writeIndex];
 
-		m_leftoverWrites--;
+		if (m_leftoverWrites > 0)
+			m_leftoverWrites--;
 		m_readIndex = writeIndex;
 	}
 
@@ -48,6 +48,7 @@ namespace digbuild::platform::desktop::vulkan
 
 		std::vector<std::shared_ptr<TextureSampler>> m_samplers;
 		std::vector<std::shared_ptr<Texture>> m_textures;
+		std::vector<vk::ImageView> m_views;
 
 		vk::UniqueDescriptorPool m_descriptorPool;
 		std::vector<vk::UniqueDescriptorSet> m_descriptorSets;
@@ -32,6 +32,18 @@ namespace digbuild::platform::desktop::vulkan
 		throw std::runtime_error("Invalid type.");
 	}
 
+	vk::SamplerMipmapMode toVulkan(const render::TextureMipmapMode mode)
+	{
+		switch (mode)
+		{
+		case render::TextureMipmapMode::LINEAR:
+			return vk::SamplerMipmapMode::eLinear;
+		case render::TextureMipmapMode::NEAREST:
+			return vk::SamplerMipmapMode::eNearest;
+		}
+		throw std::runtime_error("Invalid type.");
+	}
+
 	vk::BorderColor toVulkan(const render::TextureBorderColor color)
 	{
 		switch (color)
@@ -53,16 +65,23 @@ namespace digbuild::platform::desktop::vulkan
 		const render::TextureWrapping wrapping,
 		const render::TextureBorderColor borderColor,
 		const bool enableAnisotropy,
-		const uint32_t anisotropyLevel
+		const uint32_t anisotropyLevel,
+		const render::TextureMipmapMode mipmapMode,
+		const float minLod,
+		const float maxLod,
+		const float lodBias
 	) :
 		m_context(std::move(context))
 	{
+		if (minLod > maxLod)
+			throw std::runtime_error("Minimum LOD exceeds the maximum LOD.");
+
 		const auto addressMode = toVulkan(wrapping);
 		m_sampler = m_context->createTextureSampler(
 			toVulkan(minFiltering),
 			toVulkan(magFiltering),
 			addressMode,
-			vk::SamplerMipmapMode::eNearest, 0.0f, 0.0f, 0.0f,
+			toVulkan(mipmapMode), lodBias, minLod, maxLod,
 			enableAnisotropy, static_cast<float>(anisotropyLevel),
 			false, vk::CompareOp::eAlways,
 			toVulkan(borderColor),
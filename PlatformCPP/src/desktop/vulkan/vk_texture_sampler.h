@@ -14,7 +14,11 @@ namespace digbuild::platform::desktop::vulkan
 			render::TextureWrapping wrapping,
 			render::TextureBorderColor borderColor,
 			bool enableAnisotropy,
-			uint32_t anisotropyLevel
+			uint32_t anisotropyLevel,
+			render::TextureMipmapMode mipmapMode,
+			float minLod,
+			float maxLod,
+			float lodBias
 		);
 
 		[[nodiscard]] vk::Sampler& get()
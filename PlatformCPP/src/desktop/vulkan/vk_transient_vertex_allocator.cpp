@@ -0,0 +1,71 @@
+﻿#include "vk_transient_vertex_allocator.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	TransientVertexAllocator::TransientVertexAllocator(
+		std::shared_ptr<VulkanContext> context,
+		const uint32_t chunkSize,
+		const uint32_t frames
+	) :
+		m_belt(
+			std::move(context),
+			chunkSize,
+			frames,
+			vk::BufferUsageFlagBits::eVertexBuffer,
+			true
+		)
+	{
+	}
+
+	render::TransientVertices TransientVertexAllocator::allocate(const uint32_t size, const uint32_t vertexSize)
+	{
+		if (vertexSize == 0 || size % vertexSize != 0)
+			throw std::runtime_error("Transient vertex data must hold a whole number of vertices.");
+
+		std::scoped_lock lock(m_lock);
+		const auto allocation = m_belt.allocate(size);
+		return render::TransientVertices{
+			allocation.data,
+			render::TransientVertexRange{ allocation.chunk, allocation.offset, size, vertexSize, m_frame }
+		};
+	}
+
+	TransientVertexLocation TransientVertexAllocator::resolve(const render::TransientVertexRange& range)
+	{
+		std::scoped_lock lock(m_lock);
+		if (range.frame != m_frame)
+			throw std::runtime_error("Transient vertices can only be drawn in the frame they were allocated in.");
+
+		// Ranges are passed in by value, so make sure they still describe memory that was handed out
+		auto* chunk = m_belt.getOpenChunk(range.chunk);
+		if (!chunk || range.vertexSize == 0 || static_cast<uint64_t>(range.offset) + range.size > chunk->size())
+			throw std::runtime_error("Invalid transient vertex range.");
+
+		return TransientVertexLocation{ chunk->buffer(), range.offset, range.size / range.vertexSize };
+	}
+
+	void TransientVertexAllocator::close(const uint32_t frame)
+	{
+		std::scoped_lock lock(m_lock);
+		m_belt.close(frame);
+		m_frame++;
+	}
+
+	void TransientVertexAllocator::retire(const uint32_t frame)
+	{
+		std::scoped_lock lock(m_lock);
+		m_belt.retire(frame);
+	}
+
+	void TransientVertexAllocator::reset(const uint32_t frames)
+	{
+		std::scoped_lock lock(m_lock);
+		m_belt.reset(frames);
+	}
+
+	render::StagingStats TransientVertexAllocator::getStats()
+	{
+		std::scoped_lock lock(m_lock);
+		return m_belt.getStats();
+	}
+}
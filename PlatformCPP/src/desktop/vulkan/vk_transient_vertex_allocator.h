@@ -0,0 +1,48 @@
+﻿#pragma once
+#include <memory>
+#include <mutex>
+#include <vulkan.h>
+
+#include "vk_context.h"
+#include "vk_staging_belt.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	// Where transient vertices live, valid only while the frame they were allocated for is being built
+	struct TransientVertexLocation
+	{
+		vk::Buffer buffer;
+		uint32_t offset;
+		uint32_t vertexCount;
+	};
+
+	// Hands out vertex memory from persistently mapped chunks for geometry that is rebuilt every frame,
+	// such as UI and particles. The chunks are recycled once the frame that drew from them has finished executing.
+	class TransientVertexAllocator final
+	{
+	public:
+		TransientVertexAllocator(
+			std::shared_ptr<VulkanContext> context,
+			uint32_t chunkSize,
+			uint32_t frames
+		);
+
+		[[nodiscard]] render::TransientVertices allocate(uint32_t size, uint32_t vertexSize);
+		// Looks up a range allocated for the frame being built, which cannot be drawn once it is over
+		[[nodiscard]] TransientVertexLocation resolve(const render::TransientVertexRange& range);
+
+		// Hands everything allocated since the last call over to the frame, and starts the next one.
+		void close(uint32_t frame);
+		// Recycles the memory used by the frame. Must only be called once its fence has signaled.
+		void retire(uint32_t frame);
+		// Recycles all frames and resizes. Must only be called while the device is idle.
+		void reset(uint32_t frames);
+
+		[[nodiscard]] render::StagingStats getStats();
+
+	private:
+		std::mutex m_lock;
+		StagingBelt m_belt;
+		uint64_t m_frame = 0;
+	};
+}
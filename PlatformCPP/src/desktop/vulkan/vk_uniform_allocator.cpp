@@ -0,0 +1,84 @@
+﻿#include "vk_uniform_allocator.h"
+
+#include <algorithm>
+
+namespace digbuild::platform::desktop::vulkan
+{
+	UniformAllocation::UniformAllocation(
+		std::shared_ptr<UniformAllocator> allocator,
+		UniformPage& page,
+		const uint32_t offset,
+		const uint32_t size
+	) :
+		m_allocator(std::move(allocator)),
+		m_page(page),
+		m_offset(offset),
+		m_size(size)
+	{
+	}
+
+	UniformAllocation::~UniformAllocation()
+	{
+		m_allocator->free(m_page, m_offset, m_size);
+	}
+
+	UniformAllocator::UniformAllocator(
+		std::shared_ptr<VulkanContext> context,
+		const uint32_t pageSize
+	) :
+		m_context(std::move(context)),
+		m_pageSize(pageSize),
+		m_alignment(static_cast<uint32_t>(m_context->getLimits().minUniformBufferOffsetAlignment))
+	{
+	}
+
+	std::shared_ptr<UniformAllocation> UniformAllocator::allocate(uint32_t size)
+	{
+		size = align(size);
+
+		std::scoped_lock lock(m_lock);
+
+		for (auto& page : m_pages)
+		{
+			if (page->dedicated)
+				continue;
+			const auto offset = page->ranges.allocate(size, m_alignment);
+			if (offset)
+				return std::make_shared<UniformAllocation>(shared_from_this(), *page, *offset, size);
+		}
+
+		// Blocks that would not fit in a regular page get one of their own
+		const auto dedicated = size > m_pageSize;
+		const auto pageSize = dedicated ? size : m_pageSize;
+		// Shaders read uniforms straight from device memory when the host can write to it, and over the bus otherwise
+		auto buffer = m_context->createDirectBuffer(pageSize, vk::BufferUsageFlagBits::eUniformBuffer);
+		if (!buffer)
+			buffer = m_context->createMappedBuffer(pageSize, vk::BufferUsageFlagBits::eUniformBuffer);
+		auto& page = m_pages.emplace_back(std::make_unique<UniformPage>(UniformPage{
+			std::move(buffer),
+			util::RangeAllocator(pageSize),
+			dedicated
+		}));
+
+		const auto offset = page->ranges.allocate(size, m_alignment);
+		return std::make_shared<UniformAllocation>(shared_from_this(), *page, *offset, size);
+	}
+
+	void UniformAllocator::free(UniformPage& page, const uint32_t offset, const uint32_t size)
+	{
+		std::scoped_lock lock(m_lock);
+
+		page.ranges.free(offset, size);
+		if (!page.dedicated || !page.ranges.empty())
+			return;
+
+		const auto it = std::find_if(
+			m_pages.begin(), m_pages.end(),
+			[&](const std::unique_ptr<UniformPage>& ptr) {
+				return ptr.get() == &page;
+			}
+		);
+		if (it != m_pages.end())
+			m_pages.erase(it);
+	}
+}
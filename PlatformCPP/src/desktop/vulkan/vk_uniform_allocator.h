@@ -0,0 +1,92 @@
+﻿#pragma once
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <vulkan.h>
+
+#include "vk_buffer.h"
+#include "vk_context.h"
+#include "vk_range_allocator.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	class UniformAllocator;
+
+	struct UniformPage
+	{
+		std::unique_ptr<VulkanBuffer> buffer;
+		util::RangeAllocator ranges;
+		bool dedicated;
+	};
+
+	class UniformAllocation final
+	{
+	public:
+		UniformAllocation(
+			std::shared_ptr<UniformAllocator> allocator,
+			UniformPage& page,
+			uint32_t offset,
+			uint32_t size
+		);
+		~UniformAllocation();
+		UniformAllocation(const UniformAllocation& other) = delete;
+		UniformAllocation(UniformAllocation&& other) noexcept = delete;
+		UniformAllocation& operator=(const UniformAllocation& other) = delete;
+		UniformAllocation& operator=(UniformAllocation&& other) noexcept = delete;
+
+		[[nodiscard]] vk::Buffer& buffer() const
+		{
+			return m_page.buffer->buffer();
+		}
+		[[nodiscard]] uint32_t offset() const
+		{
+			return m_offset;
+		}
+		[[nodiscard]] uint32_t size() const
+		{
+			return m_size;
+		}
+		[[nodiscard]] uint8_t* data() const
+		{
+			return m_page.buffer->mappedMemory() + m_offset;
+		}
+		[[nodiscard]] bool isDirect() const
+		{
+			return m_page.buffer->isDirect();
+		}
+
+	private:
+		std::shared_ptr<UniformAllocator> m_allocator;
+		UniformPage& m_page;
+		uint32_t m_offset, m_size;
+	};
+
+	class UniformAllocator final : public std::enable_shared_from_this<UniformAllocator>
+	{
+	public:
+		UniformAllocator(
+			std::shared_ptr<VulkanContext> context,
+			uint32_t pageSize
+		);
+
+		// Rounds a size up so consecutive blocks can be addressed with descriptor and dynamic offsets.
+		[[nodiscard]] uint32_t align(uint32_t size) const
+		{
+			return util::alignUp(size, m_alignment);
+		}
+
+		[[nodiscard]] std::shared_ptr<UniformAllocation> allocate(uint32_t size);
+
+	private:
+		void free(UniformPage& page, uint32_t offset, uint32_t size);
+
+		std::shared_ptr<VulkanContext> m_context;
+		uint32_t m_pageSize;
+		uint32_t m_alignment;
+
+		std::mutex m_lock;
+		std::vector<std::unique_ptr<UniformPage>> m_pages;
+
+		friend class UniformAllocation;
+	};
+}
@@ -45,7 +45,8 @@ namespace digbuild::platform::desktop::vulkan
 			return;
 		}
 		
-		const vk::DescriptorBufferInfo bufferInfo{ m_buffers[writeIndex]->buffer(), 0, m_bindingSize };
+		const auto& buffer = m_buffers[writeIndex];
+		const vk::DescriptorBufferInfo bufferInfo{ buffer->buffer(), buffer->offset(), m_bindingSize };
 		const vk::WriteDescriptorSet write{
 			*m_descriptorSets[writeIndex],
 			m_binding,
@@ -66,9 +67,9 @@ namespace digbuild::platform::desktop::vulkan
 		m_readIndex = writeIndex;
 	}
 
-	void UniformBinding::updateNext()
+	void UniformBinding::updateAll()
 	{
-		m_leftoverWrites = std::max(1u, m_leftoverWrites);
+		m_leftoverWrites = static_cast<uint32_t>(m_descriptorSets.size());
 	}
 
 	void UniformBinding::update(
@@ -47,7 +47,7 @@ namespace digbuild::platform::desktop::vulkan
 			return m_bindingSize;
 		}
 
-		void updateNext();
+		void updateAll();
 
 	private:
 		void update(
@@ -4,20 +4,31 @@ namespace digbuild::platform::desktop::vulkan
 {
 	UniformBuffer::UniformBuffer(
 		std::shared_ptr<VulkanContext> context,
+		std::shared_ptr<UniformAllocator> allocator,
+		std::shared_ptr<UploadStream> uploadStream,
 		const uint32_t stages,
 		const std::vector<uint8_t>& initialData
 	) :
-		m_context(std::move(context))
+		m_context(std::move(context)),
+		m_allocator(std::move(allocator)),
+		m_uploadStream(std::move(uploadStream)),
+		m_stages(stages)
 	{
-		m_buffers.resize(stages);
-
 		if (!initialData.empty())
 			write(initialData);
 	}
 
+	UniformBuffer::~UniformBuffer()
+	{
+		if (m_allocation)
+			m_uploadStream->retain(std::move(m_allocation));
+	}
+
 	void UniformBuffer::tick()
 	{
-		const auto writeIndex = (m_readIndex + 1) % static_cast<uint32_t>(m_buffers.size());
+		const auto writeIndex = (m_readIndex + 1) % m_stages;
+
+		m_capacity.tick(m_stride, m_size);
 
 		if (m_leftoverWrites == 0)
 		{
@@ -32,53 +43,81 @@ namespace digbuild::platform::desktop::vulkan
 			return;
 		}
 		
-		auto& buffer = m_buffers[writeIndex];
-		
-		if (!buffer || buffer->size() < m_uniformData.size())
+		// Every stage lives in the same allocation, so all of them move together. This can only
+		// happen before the first stage is written, as the others would lose their contents.
+		const auto stride = m_allocator->align(m_capacity.fit(m_stride, m_size));
+		if (!m_allocation || (m_leftoverWrites == m_stages && stride != m_stride))
 		{
-			buffer = m_context->createBuffer(
-				static_cast<uint32_t>(m_uniformData.size()),
-				vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eTransferDst,
-				vk::SharingMode::eExclusive,
-				{}
-			);
+			if (m_allocation)
+				m_uploadStream->retain(std::move(m_allocation));
+			m_capacity.reallocated();
+			m_stride = stride;
+			m_allocation = m_allocator->allocate(m_stride * m_stages);
 
 			for (const auto& dependent : m_dependents)
 			{
 				const auto binding = dependent.lock();
 				if (binding)
-					binding->updateNext();
+					binding->updateAll();
 			}
 		}
 		
-		auto buf = m_context->createCpuToGpuTransferBuffer(
+		memcpy(
+			m_allocation->data() + writeIndex * m_stride,
 			m_uniformData.data(),
-			static_cast<uint32_t>(m_uniformData.size())
-		);
-
-		util::copyBufferToBufferImmediate(
-			*m_context->m_device,
-			*m_context->m_commandPool,
-			m_context->m_graphicsQueue,
-			buf->buffer(),
-			buffer->buffer(),
-			static_cast<uint32_t>(m_uniformData.size())
+			m_uniformData.size()
 		);
 
 		m_leftoverWrites--;
 		m_readIndex = writeIndex;
 
+		// Keeps the capacity around for the next write
 		if (m_leftoverWrites == 0)
-		{
 			m_uniformData.clear();
-			m_uniformData.shrink_to_fit();
-		}
 	}
 
 	void UniformBuffer::write(const std::vector<uint8_t>& data)
 	{
 		m_uniformData.assign(data.begin(), data.end());
-		m_leftoverWrites = static_cast<uint32_t>(m_buffers.size());
+		m_size = static_cast<uint32_t>(data.size());
+		m_leftoverWrites = m_stages;
+	}
+
+	void* UniformBuffer::map(const uint32_t size)
+	{
+		// Mapped data is kept apart from the data still being written to the stages until it is committed
+		m_mappedData.resize(size);
+		m_mapped = true;
+		return m_mappedData.data();
+	}
+
+	void UniformBuffer::commit(const uint32_t size)
+	{
+		if (!m_mapped)
+			throw std::runtime_error("Uniform buffer must be mapped before committing.");
+		if (size > m_mappedData.size())
+			throw std::runtime_error("Committed size exceeds the mapped size.");
+
+		m_mappedData.resize(size);
+		m_uniformData.swap(m_mappedData);
+		m_size = size;
+		m_mapped = false;
+		m_leftoverWrites = m_stages;
+	}
+
+	void UniformBuffer::setCapacityPolicy(const render::BufferCapacityPolicy& policy)
+	{
+		m_capacity.setPolicy(policy);
+	}
+
+	render::BufferStats UniformBuffer::getStats()
+	{
+		return render::BufferStats{
+			static_cast<uint64_t>(m_stride) * m_stages,
+			static_cast<uint64_t>(m_size) * m_stages,
+			m_capacity.getReallocations(),
+			m_allocation && m_allocation->isDirect() ? static_cast<uint64_t>(m_stride) * m_stages : 0
+		};
 	}
 
 	void UniformBuffer::registerUser(const std::weak_ptr<UniformBinding>& binding)
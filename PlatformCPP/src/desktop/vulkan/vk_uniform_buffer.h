@@ -1,7 +1,10 @@
 ﻿#pragma once
+#include "vk_buffer_capacity.h"
 #include "vk_context.h"
 #include "vk_shader.h"
+#include "vk_uniform_allocator.h"
 #include "vk_uniform_binding.h"
+#include "vk_upload_stream.h"
 #include "../../render/uniform_buffer.h"
 
 namespace digbuild::platform::desktop::vulkan
@@ -11,17 +14,33 @@ namespace digbuild::platform::desktop::vulkan
 	public:
 		UniformBuffer(
 			std::shared_ptr<VulkanContext> context,
+			std::shared_ptr<UniformAllocator> allocator,
+			std::shared_ptr<UploadStream> uploadStream,
 			uint32_t stages,
 			const std::vector<uint8_t>& initialData
 		);
+		~UniformBuffer() override;
 
 		void tick();
 		
 		void write(const std::vector<uint8_t>& data) override;
 
+		[[nodiscard]] void* map(uint32_t size) override;
+
+		void commit(uint32_t size) override;
+
+		void setCapacityPolicy(const render::BufferCapacityPolicy& policy) override;
+
+		[[nodiscard]] render::BufferStats getStats() override;
+
 		[[nodiscard]] vk::Buffer& buffer()
 		{
-			return m_buffers[m_readIndex]->buffer();
+			return m_allocation->buffer();
+		}
+
+		[[nodiscard]] uint32_t offset() const
+		{
+			return m_allocation->offset() + m_readIndex * m_stride;
 		}
 
 		void registerUser(const std::weak_ptr<UniformBinding>& binding);
@@ -30,9 +49,17 @@ namespace digbuild::platform::desktop::vulkan
 
 	private:
 		std::shared_ptr<VulkanContext> m_context;
+		std::shared_ptr<UniformAllocator> m_allocator;
+		std::shared_ptr<UploadStream> m_uploadStream;
 
-		std::vector<std::unique_ptr<VulkanBuffer>> m_buffers;
+		std::shared_ptr<UniformAllocation> m_allocation;
+		uint32_t m_stages;
+		uint32_t m_stride = 0;
+		uint32_t m_size = 0;
+		util::BufferCapacity m_capacity;
 		std::vector<uint8_t> m_uniformData;
+		std::vector<uint8_t> m_mappedData;
+		bool m_mapped = false;
 
 		std::set<std::weak_ptr<UniformBinding>, std::owner_less<>> m_dependents;
 
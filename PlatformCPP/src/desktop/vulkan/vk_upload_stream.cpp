@@ -0,0 +1,771 @@
+﻿#include "vk_upload_stream.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "vk_range_allocator.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	const vk::PipelineStageFlags UPLOAD_CONSUMER_STAGES =
+		vk::PipelineStageFlagBits::eDrawIndirect |
+		vk::PipelineStageFlagBits::eVertexInput |
+		vk::PipelineStageFlagBits::eVertexShader |
+		vk::PipelineStageFlagBits::eFragmentShader;
+	const vk::AccessFlags UPLOAD_CONSUMER_ACCESS =
+		vk::AccessFlagBits::eIndirectCommandRead |
+		vk::AccessFlagBits::eVertexAttributeRead |
+		vk::AccessFlagBits::eIndexRead |
+		vk::AccessFlagBits::eUniformRead |
+		vk::AccessFlagBits::eShaderRead;
+
+	constexpr uint32_t STAGING_CHUNK_SIZE = 4 * 1024 * 1024;
+
+	vk::ImageSubresourceRange getFullRange(const ImageUpload& image)
+	{
+		return vk::ImageSubresourceRange{
+			image.aspectFlags,
+			0, VK_REMAINING_MIP_LEVELS,
+			0, VK_REMAINING_ARRAY_LAYERS
+		};
+	}
+
+	// Images that get their mips generated stay writable until the blits on the graphics queue are done
+	vk::ImageLayout getTransferLayout(const ImageUpload& image)
+	{
+		return image.mipGeneration ? vk::ImageLayout::eTransferDstOptimal : image.finalLayout;
+	}
+
+	// Satisfies the offset requirements of every uploadable format, the largest texel blocks being 16 bytes
+	constexpr uint32_t IMAGE_WRITE_ALIGNMENT = 16;
+
+	bool overlapsRange(const int64_t aStart, const int64_t aSize, const int64_t bStart, const int64_t bSize)
+	{
+		return aStart < bStart + bSize && bStart < aStart + aSize;
+	}
+
+	bool containsRange(const int64_t outerStart, const int64_t outerSize, const int64_t innerStart, const int64_t innerSize)
+	{
+		return outerStart <= innerStart && innerStart + innerSize <= outerStart + outerSize;
+	}
+
+	bool overlaps(const vk::BufferImageCopy& a, const vk::BufferImageCopy& b)
+	{
+		return a.imageSubresource.mipLevel == b.imageSubresource.mipLevel &&
+			overlapsRange(
+				a.imageSubresource.baseArrayLayer, a.imageSubresource.layerCount,
+				b.imageSubresource.baseArrayLayer, b.imageSubresource.layerCount
+			) &&
+			overlapsRange(a.imageOffset.x, a.imageExtent.width, b.imageOffset.x, b.imageExtent.width) &&
+			overlapsRange(a.imageOffset.y, a.imageExtent.height, b.imageOffset.y, b.imageExtent.height);
+	}
+
+	bool contains(const vk::BufferImageCopy& outer, const vk::BufferImageCopy& inner)
+	{
+		return outer.imageSubresource.mipLevel == inner.imageSubresource.mipLevel &&
+			containsRange(
+				outer.imageSubresource.baseArrayLayer, outer.imageSubresource.layerCount,
+				inner.imageSubresource.baseArrayLayer, inner.imageSubresource.layerCount
+			) &&
+			containsRange(outer.imageOffset.x, outer.imageExtent.width, inner.imageOffset.x, inner.imageExtent.width) &&
+			containsRange(outer.imageOffset.y, outer.imageExtent.height, inner.imageOffset.y, inner.imageExtent.height);
+	}
+
+	UploadStream::UploadStream(
+		std::shared_ptr<VulkanContext> context,
+		const uint32_t frames
+	) :
+		m_context(std::move(context)),
+		m_dedicatedTransfer(m_context->hasTransferQueue()),
+		m_stagingBelt(m_context, STAGING_CHUNK_SIZE, frames)
+	{
+		reset(frames);
+	}
+
+	void UploadStream::copyToBuffer(
+		const void* data,
+		const uint32_t size,
+		const std::shared_ptr<VulkanBuffer>& dst,
+		const uint32_t dstOffset
+	)
+	{
+		if (size == 0)
+			return;
+
+		// The lock is held while copying so the staging memory cannot be handed to a frame before the copy is queued
+		std::scoped_lock lock(m_lock);
+		const auto staging = m_stagingBelt.allocate(size);
+		memcpy(staging.data, data, size);
+
+		queueBufferCopy(staging.buffer, staging.offset, dst, dstOffset, size);
+	}
+
+	void UploadStream::copyBuffer(
+		const std::shared_ptr<VulkanBuffer>& src,
+		const uint32_t srcOffset,
+		const std::shared_ptr<VulkanBuffer>& dst,
+		const uint32_t dstOffset,
+		const uint32_t size
+	)
+	{
+		if (size == 0)
+			return;
+
+		std::scoped_lock lock(m_lock);
+		queueBufferCopy(src.get(), srcOffset, dst, dstOffset, size);
+		m_pendingResources.push_back(src);
+	}
+
+	void UploadStream::copyToImage(
+		const void* data,
+		const uint32_t size,
+		CopyCommand copy,
+		std::vector<std::shared_ptr<void>> resources,
+		const ImageUpload image
+	)
+	{
+		std::scoped_lock lock(m_lock);
+		const auto staging = m_stagingBelt.allocate(size);
+		memcpy(staging.data, data, size);
+
+		m_transfers.commands.emplace_back(
+			[copy = std::move(copy), src = staging.buffer, srcOffset = staging.offset](const vk::CommandBuffer& cmd)
+			{
+				copy(cmd, src->buffer(), srcOffset);
+			}
+		);
+		m_transfers.images.push_back(image);
+		m_pendingResources.insert(
+			m_pendingResources.end(),
+			std::make_move_iterator(resources.begin()),
+			std::make_move_iterator(resources.end())
+		);
+	}
+
+	void UploadStream::copyToImageAsync(
+		const void* data,
+		const uint32_t size,
+		CopyCommand copy,
+		std::vector<std::shared_ptr<void>> resources,
+		const ImageUpload image,
+		std::function<void()> onComplete
+	)
+	{
+		// Asynchronous uploads are not tied to a frame, so they cannot use the staging belt
+		std::shared_ptr<VulkanBuffer> src = m_context->createCpuToGpuTransferBuffer(data, size);
+		std::function<void(const vk::CommandBuffer&)> command =
+			[copy = std::move(copy), src = src.get()](const vk::CommandBuffer& cmd)
+			{
+				copy(cmd, src->buffer(), 0);
+			};
+		resources.push_back(std::move(src));
+
+		std::scoped_lock lock(m_lock);
+		m_pendingUploads.push_back(AsyncUpload{
+			TransferBatch{ { std::move(command) }, {}, { image } },
+			std::move(resources),
+			std::move(onComplete)
+		});
+	}
+
+	void UploadStream::copyRegionsToBuffer(
+		const uint8_t* data,
+		const std::vector<vk::BufferCopy>& regions,
+		const std::shared_ptr<VulkanBuffer>& dst
+	)
+	{
+		if (regions.empty())
+			return;
+
+		vk::DeviceSize size = 0;
+		for (const auto& region : regions)
+			size += region.size;
+
+		std::scoped_lock lock(m_lock);
+		const auto staging = m_stagingBelt.allocate(static_cast<uint32_t>(size));
+
+		// Regions are packed back to back in the staging memory
+		std::vector<vk::BufferCopy> stagedRegions;
+		stagedRegions.reserve(regions.size());
+		vk::DeviceSize offset = 0;
+		for (const auto& region : regions)
+		{
+			memcpy(staging.data + offset, data + region.srcOffset, region.size);
+			stagedRegions.emplace_back(staging.offset + offset, region.dstOffset, region.size);
+			offset += region.size;
+		}
+
+		// Contents that are not overwritten must survive, so the copy cannot go through the transfer queue
+		m_commands.emplace_back(
+			[src = staging.buffer, dst = dst.get(), regions = std::move(stagedRegions)](const vk::CommandBuffer& cmd)
+			{
+				cmd.copyBuffer(src->buffer(), dst->buffer(), regions);
+			}
+		);
+		m_pendingResources.push_back(dst);
+	}
+
+	void UploadStream::copyBufferRegions(
+		const std::shared_ptr<VulkanBuffer>& src,
+		const std::shared_ptr<VulkanBuffer>& dst,
+		std::vector<vk::BufferCopy> regions
+	)
+	{
+		if (regions.empty())
+			return;
+
+		std::scoped_lock lock(m_lock);
+		m_commands.emplace_back(
+			[src = src.get(), dst = dst.get(), regions = std::move(regions)](const vk::CommandBuffer& cmd)
+			{
+				cmd.copyBuffer(src->buffer(), dst->buffer(), regions);
+			}
+		);
+		m_pendingResources.push_back(src);
+		m_pendingResources.push_back(dst);
+	}
+
+	void UploadStream::copyToImageRegion(
+		const void* data,
+		const uint32_t size,
+		const std::shared_ptr<VulkanImage>& dst,
+		const vk::ImageAspectFlags aspectFlags,
+		const vk::ImageLayout layout,
+		const vk::ImageSubresourceLayers& subresource,
+		const vk::Offset3D offset,
+		const vk::Extent3D extent
+	)
+	{
+		const vk::BufferImageCopy region{ 0, 0, 0, subresource, offset, extent };
+
+		std::scoped_lock lock(m_lock);
+
+		ImageWriteBatch* batch = nullptr;
+		for (auto it = m_imageWrites.rbegin(); it != m_imageWrites.rend(); ++it)
+		{
+			if (it->image == dst)
+			{
+				batch = &*it;
+				break;
+			}
+		}
+
+		if (batch)
+		{
+			auto& regions = batch->regions;
+			regions.erase(
+				std::remove_if(regions.begin(), regions.end(), [&](const auto& r) { return contains(region, r); }),
+				regions.end()
+			);
+			if (regions.empty())
+				batch->data.clear();
+
+			// Overlapping regions within one copy are undefined, so a partial overlap starts a batch that is copied after
+			if (std::any_of(regions.begin(), regions.end(), [&](const auto& r) { return overlaps(region, r); }))
+				batch = nullptr;
+		}
+		if (!batch)
+			batch = &m_imageWrites.emplace_back(ImageWriteBatch{ dst, aspectFlags, layout });
+
+		const auto dataOffset = util::alignUp(static_cast<uint32_t>(batch->data.size()), IMAGE_WRITE_ALIGNMENT);
+		batch->data.resize(dataOffset + size);
+		memcpy(batch->data.data() + dataOffset, data, size);
+		batch->regions.push_back(region);
+		batch->regions.back().bufferOffset = dataOffset;
+	}
+
+	void UploadStream::enqueue(
+		std::function<void(const vk::CommandBuffer&)> commands,
+		std::vector<std::shared_ptr<void>> resources
+	)
+	{
+		std::scoped_lock lock(m_lock);
+		m_commands.push_back(std::move(commands));
+		m_pendingResources.insert(
+			m_pendingResources.end(),
+			std::make_move_iterator(resources.begin()),
+			std::make_move_iterator(resources.end())
+		);
+	}
+
+	void UploadStream::retain(std::shared_ptr<void> resource)
+	{
+		std::scoped_lock lock(m_lock);
+		m_pendingResources.push_back(std::move(resource));
+	}
+
+	vk::Semaphore UploadStream::record(const vk::CommandBuffer& cmd, const uint32_t frame)
+	{
+		std::scoped_lock lock(m_lock);
+		flushImageWrites();
+
+		vk::Semaphore waitSemaphore = nullptr;
+		const auto graphicsTransfers = !m_dedicatedTransfer && !m_transfers.empty();
+
+		if (m_dedicatedTransfer && !m_transfers.empty())
+		{
+			auto& transferCmd = m_transferCommandBuffers[frame];
+			transferCmd.begin(vk::CommandBufferBeginInfo{
+				vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+			});
+			recordTransfer(transferCmd, m_transfers);
+			transferCmd.end();
+
+			waitSemaphore = m_transferSemaphores[frame];
+			m_context->submitTransfer(transferCmd, waitSemaphore);
+
+			recordAcquire(cmd, m_transfers);
+		}
+
+		if (graphicsTransfers || !m_commands.empty())
+		{
+			// Previous frames may still be reading from the buffers we are about to overwrite,
+			// and copies between device buffers read what earlier frames wrote
+			cmd.pipelineBarrier(
+				UPLOAD_CONSUMER_STAGES | vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eTransfer,
+				{},
+				{ vk::MemoryBarrier{
+					vk::AccessFlagBits::eTransferWrite,
+					vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite
+				} },
+				{},
+				{}
+			);
+
+			if (graphicsTransfers)
+				recordTransfer(cmd, m_transfers);
+
+			// Queued commands may update buffers the transfers have just written
+			if (graphicsTransfers && !m_commands.empty())
+			{
+				cmd.pipelineBarrier(
+					vk::PipelineStageFlagBits::eTransfer,
+					vk::PipelineStageFlagBits::eTransfer,
+					{},
+					{ vk::MemoryBarrier{
+						vk::AccessFlagBits::eTransferWrite,
+						vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite
+					} },
+					{},
+					{}
+				);
+			}
+
+			for (const auto& command : m_commands)
+				command(cmd);
+			m_commands.clear();
+
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				UPLOAD_CONSUMER_STAGES,
+				{},
+				{ vk::MemoryBarrier{ vk::AccessFlagBits::eTransferWrite, UPLOAD_CONSUMER_ACCESS } },
+				{},
+				{}
+			);
+		}
+
+		m_transfers = {};
+		m_stagingBelt.close(frame);
+
+		auto& resources = m_frameResources[frame];
+		resources.insert(
+			resources.end(),
+			std::make_move_iterator(m_pendingResources.begin()),
+			std::make_move_iterator(m_pendingResources.end())
+		);
+		m_pendingResources.clear();
+
+		return waitSemaphore;
+	}
+
+	void UploadStream::submit()
+	{
+		std::vector<AsyncUpload> uploads;
+		{
+			std::scoped_lock lock(m_lock);
+			uploads.swap(m_pendingUploads);
+		}
+
+		for (auto& upload : uploads)
+		{
+			upload.commandBuffer = m_context->createCommandBuffer(1, vk::CommandBufferLevel::ePrimary);
+			upload.fence = m_context->createFence(1, false);
+
+			auto& cmd = upload.commandBuffer[0];
+			cmd.begin(vk::CommandBufferBeginInfo{
+				vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+			});
+
+			if (m_dedicatedTransfer)
+			{
+				upload.transferCommandBuffer = m_context->createTransferCommandBuffer(1);
+				upload.semaphore = m_context->createSemaphore(1);
+
+				auto& transferCmd = upload.transferCommandBuffer[0];
+				transferCmd.begin(vk::CommandBufferBeginInfo{
+					vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+				});
+				recordTransfer(transferCmd, upload.batch);
+				transferCmd.end();
+				m_context->submitTransfer(transferCmd, upload.semaphore[0]);
+
+				recordAcquire(cmd, upload.batch);
+				cmd.end();
+				m_context->submit(cmd, { upload.semaphore[0] }, { getWaitStages() }, nullptr, upload.fence[0]);
+			}
+			else
+			{
+				recordTransfer(cmd, upload.batch);
+				cmd.end();
+				m_context->submit(cmd, upload.fence[0]);
+			}
+
+			m_submittedUploads.push_back(std::move(upload));
+		}
+	}
+
+	void UploadStream::retire(const uint32_t frame)
+	{
+		std::vector<std::shared_ptr<void>> resources;
+		{
+			std::scoped_lock lock(m_lock);
+			resources.swap(m_frameResources[frame]);
+			m_stagingBelt.retire(frame);
+		}
+		// Resources are released outside of the lock, as their destructors may queue more work
+	}
+
+	void UploadStream::poll()
+	{
+		std::vector<AsyncUpload> completed;
+		for (auto it = m_submittedUploads.begin(); it != m_submittedUploads.end();)
+		{
+			if (!m_context->isSignaled(it->fence[0]))
+			{
+				++it;
+				continue;
+			}
+			completed.push_back(std::move(*it));
+			it = m_submittedUploads.erase(it);
+		}
+
+		for (auto& upload : completed)
+			if (upload.onComplete)
+				upload.onComplete();
+	}
+
+	void UploadStream::reset(const uint32_t frames)
+	{
+		std::vector<std::vector<std::shared_ptr<void>>> resources;
+		{
+			std::scoped_lock lock(m_lock);
+			resources.swap(m_frameResources);
+			m_frameResources.resize(frames);
+			m_stagingBelt.reset(frames);
+		}
+
+		if (m_dedicatedTransfer)
+		{
+			m_transferCommandBuffers = m_context->createTransferCommandBuffer(frames);
+			m_transferSemaphores = m_context->createSemaphore(frames);
+		}
+
+		poll();
+	}
+
+	render::StagingStats UploadStream::getStagingStats()
+	{
+		std::scoped_lock lock(m_lock);
+		return m_stagingBelt.getStats();
+	}
+
+	vk::PipelineStageFlags UploadStream::getWaitStages()
+	{
+		return UPLOAD_CONSUMER_STAGES | vk::PipelineStageFlagBits::eTransfer;
+	}
+
+	void UploadStream::queueBufferCopy(
+		VulkanBuffer* src,
+		const uint32_t srcOffset,
+		const std::shared_ptr<VulkanBuffer>& dst,
+		const uint32_t dstOffset,
+		const uint32_t size
+	)
+	{
+		m_transfers.commands.emplace_back(
+			[src, srcOffset, dst = dst.get(), size, dstOffset](const vk::CommandBuffer& cmd)
+			{
+				const auto regions = { vk::BufferCopy{ srcOffset, dstOffset, size } };
+				cmd.copyBuffer(src->buffer(), dst->buffer(), regions);
+			}
+		);
+		if (std::find(m_transfers.buffers.begin(), m_transfers.buffers.end(), dst->buffer()) == m_transfers.buffers.end())
+			m_transfers.buffers.push_back(dst->buffer());
+		m_pendingResources.push_back(dst);
+	}
+
+	void UploadStream::flushImageWrites()
+	{
+		for (auto& batch : m_imageWrites)
+		{
+			if (batch.regions.empty())
+				continue;
+
+			const auto size = static_cast<uint32_t>(batch.data.size());
+			const auto staging = m_stagingBelt.allocate(size);
+			memcpy(staging.data, batch.data.data(), size);
+			for (auto& region : batch.regions)
+				region.bufferOffset += staging.offset;
+
+			// Contents that are not overwritten must survive, so the copy cannot go through the transfer queue
+			m_commands.emplace_back(
+				[src = staging.buffer, dst = batch.image.get(), regions = std::move(batch.regions),
+					aspectFlags = batch.aspectFlags, layout = batch.layout](const vk::CommandBuffer& cmd)
+				{
+					vk::ImageMemoryBarrier barrier{
+						vk::AccessFlags{}, vk::AccessFlagBits::eTransferWrite,
+						layout, vk::ImageLayout::eTransferDstOptimal,
+						VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+						dst->get(),
+						vk::ImageSubresourceRange{ aspectFlags, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS }
+					};
+					cmd.pipelineBarrier(
+						UPLOAD_CONSUMER_STAGES,
+						vk::PipelineStageFlagBits::eTransfer,
+						{}, {}, {}, barrier
+					);
+
+					cmd.copyBufferToImage(src->buffer(), dst->get(), vk::ImageLayout::eTransferDstOptimal, regions);
+
+					barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+					barrier.dstAccessMask = UPLOAD_CONSUMER_ACCESS;
+					barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+					barrier.newLayout = layout;
+					cmd.pipelineBarrier(
+						vk::PipelineStageFlagBits::eTransfer,
+						UPLOAD_CONSUMER_STAGES,
+						{}, {}, {}, barrier
+					);
+				}
+			);
+			m_pendingResources.push_back(std::move(batch.image));
+		}
+		m_imageWrites.clear();
+	}
+
+	void UploadStream::recordTransfer(const vk::CommandBuffer& cmd, const TransferBatch& batch) const
+	{
+		if (!batch.images.empty())
+		{
+			std::vector<vk::ImageMemoryBarrier> barriers;
+			barriers.reserve(batch.images.size());
+			for (const auto& image : batch.images)
+			{
+				barriers.emplace_back(
+					vk::AccessFlags{}, vk::AccessFlagBits::eTransferWrite,
+					vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
+					VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+					image.image, getFullRange(image)
+				);
+			}
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTopOfPipe,
+				vk::PipelineStageFlagBits::eTransfer,
+				{}, {}, {}, barriers
+			);
+		}
+
+		for (const auto& command : batch.commands)
+			command(cmd);
+
+		// Hand the written resources over to the graphics queue, which acquires them in recordAcquire
+		if (m_dedicatedTransfer)
+		{
+			const auto srcFamily = m_context->getTransferFamily();
+			const auto dstFamily = m_context->getGraphicsFamily();
+
+			std::vector<vk::BufferMemoryBarrier> bufferBarriers;
+			bufferBarriers.reserve(batch.buffers.size());
+			for (const auto& buffer : batch.buffers)
+			{
+				bufferBarriers.emplace_back(
+					vk::AccessFlagBits::eTransferWrite, vk::AccessFlags{},
+					srcFamily, dstFamily,
+					buffer, 0, VK_WHOLE_SIZE
+				);
+			}
+
+			std::vector<vk::ImageMemoryBarrier> imageBarriers;
+			imageBarriers.reserve(batch.images.size());
+			for (const auto& image : batch.images)
+			{
+				imageBarriers.emplace_back(
+					vk::AccessFlagBits::eTransferWrite, vk::AccessFlags{},
+					vk::ImageLayout::eTransferDstOptimal, getTransferLayout(image),
+					srcFamily, dstFamily,
+					image.image, getFullRange(image)
+				);
+			}
+
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eBottomOfPipe,
+				{}, {}, bufferBarriers, imageBarriers
+			);
+			return;
+		}
+
+		if (!batch.images.empty())
+		{
+			std::vector<vk::ImageMemoryBarrier> barriers;
+			barriers.reserve(batch.images.size());
+			for (const auto& image : batch.images)
+			{
+				if (image.mipGeneration)
+					continue;
+				barriers.emplace_back(
+					vk::AccessFlagBits::eTransferWrite, UPLOAD_CONSUMER_ACCESS,
+					vk::ImageLayout::eTransferDstOptimal, image.finalLayout,
+					VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+					image.image, getFullRange(image)
+				);
+			}
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				UPLOAD_CONSUMER_STAGES,
+				{},
+				{ vk::MemoryBarrier{ vk::AccessFlagBits::eTransferWrite, UPLOAD_CONSUMER_ACCESS } },
+				{},
+				barriers
+			);
+
+			for (const auto& image : batch.images)
+				if (image.mipGeneration)
+					recordMipGeneration(cmd, image);
+		}
+		else
+		{
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				UPLOAD_CONSUMER_STAGES,
+				{},
+				{ vk::MemoryBarrier{ vk::AccessFlagBits::eTransferWrite, UPLOAD_CONSUMER_ACCESS } },
+				{},
+				{}
+			);
+		}
+	}
+
+	void UploadStream::recordAcquire(const vk::CommandBuffer& cmd, const TransferBatch& batch) const
+	{
+		const auto srcFamily = m_context->getTransferFamily();
+		const auto dstFamily = m_context->getGraphicsFamily();
+		const auto dstAccess = UPLOAD_CONSUMER_ACCESS | vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite;
+
+		std::vector<vk::BufferMemoryBarrier> bufferBarriers;
+		bufferBarriers.reserve(batch.buffers.size());
+		for (const auto& buffer : batch.buffers)
+		{
+			bufferBarriers.emplace_back(
+				vk::AccessFlags{}, dstAccess,
+				srcFamily, dstFamily,
+				buffer, 0, VK_WHOLE_SIZE
+			);
+		}
+
+		std::vector<vk::ImageMemoryBarrier> imageBarriers;
+		imageBarriers.reserve(batch.images.size());
+		for (const auto& image : batch.images)
+		{
+			imageBarriers.emplace_back(
+				vk::AccessFlags{}, dstAccess,
+				vk::ImageLayout::eTransferDstOptimal, getTransferLayout(image),
+				srcFamily, dstFamily,
+				image.image, getFullRange(image)
+			);
+		}
+
+		// The source stages match the semaphore wait stages, chaining the barrier to the transfer submission
+		cmd.pipelineBarrier(
+			getWaitStages(),
+			getWaitStages(),
+			{}, {}, bufferBarriers, imageBarriers
+		);
+
+		// Blits need a graphics queue, so generation happens after the images have been acquired
+		for (const auto& image : batch.images)
+			if (image.mipGeneration)
+				recordMipGeneration(cmd, image);
+	}
+
+	void UploadStream::recordMipGeneration(const vk::CommandBuffer& cmd, const ImageUpload& image) const
+	{
+		const auto& mips = *image.mipGeneration;
+		auto width = static_cast<int32_t>(mips.width);
+		auto height = static_cast<int32_t>(mips.height);
+
+		vk::ImageMemoryBarrier barrier{
+			vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferRead,
+			vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eTransferSrcOptimal,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			image.image,
+			vk::ImageSubresourceRange{ image.aspectFlags, 0, 1, 0, mips.layers }
+		};
+
+		// Each level is downsampled from the one above it, once that one has been written
+		for (auto level = 1u; level < mips.mipLevels; ++level)
+		{
+			barrier.subresourceRange.baseMipLevel = level - 1;
+			cmd.pipelineBarrier(
+				vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eTransfer,
+				{}, {}, {}, barrier
+			);
+
+			const auto nextWidth = std::max(width / 2, 1);
+			const auto nextHeight = std::max(height / 2, 1);
+			cmd.blitImage(
+				image.image, vk::ImageLayout::eTransferSrcOptimal,
+				image.image, vk::ImageLayout::eTransferDstOptimal,
+				vk::ImageBlit{
+					{ image.aspectFlags, level - 1, 0, mips.layers },
+					std::array{ vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ width, height, 1 } },
+					{ image.aspectFlags, level, 0, mips.layers },
+					std::array{ vk::Offset3D{ 0, 0, 0 }, vk::Offset3D{ nextWidth, nextHeight, 1 } }
+				},
+				mips.filter
+			);
+
+			width = nextWidth;
+			height = nextHeight;
+		}
+
+		// Every level but the last has been a blit source
+		std::vector<vk::ImageMemoryBarrier> barriers;
+		if (mips.mipLevels > 1)
+		{
+			barriers.emplace_back(
+				vk::AccessFlagBits::eTransferRead, UPLOAD_CONSUMER_ACCESS,
+				vk::ImageLayout::eTransferSrcOptimal, image.finalLayout,
+				VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+				image.image,
+				vk::ImageSubresourceRange{ image.aspectFlags, 0, mips.mipLevels - 1, 0, mips.layers }
+			);
+		}
+		barriers.emplace_back(
+			vk::AccessFlagBits::eTransferWrite, UPLOAD_CONSUMER_ACCESS,
+			vk::ImageLayout::eTransferDstOptimal, image.finalLayout,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+			image.image,
+			vk::ImageSubresourceRange{ image.aspectFlags, mips.mipLevels - 1, 1, 0, mips.layers }
+		);
+		cmd.pipelineBarrier(
+			vk::PipelineStageFlagBits::eTransfer,
+			UPLOAD_CONSUMER_STAGES,
+			{}, {}, {}, barriers
+		);
+	}
+}
@@ -0,0 +1,203 @@
+﻿#pragma once
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <vulkan.h>
+
+#include "vk_buffer.h"
+#include "vk_context.h"
+#include "vk_image.h"
+#include "vk_staging_belt.h"
+
+namespace digbuild::platform::desktop::vulkan
+{
+	struct MipGeneration
+	{
+		uint32_t width, height;
+		uint32_t mipLevels, layers;
+		vk::Filter filter;
+	};
+
+	struct ImageUpload
+	{
+		vk::Image image;
+		vk::ImageAspectFlags aspectFlags;
+		vk::ImageLayout finalLayout;
+		// When set, only the base level is copied and the rest are blitted from it on the graphics queue
+		std::optional<MipGeneration> mipGeneration;
+	};
+
+	class UploadStream final
+	{
+	public:
+		using CopyCommand = std::function<void(const vk::CommandBuffer& cmd, const vk::Buffer& src, uint32_t srcOffset)>;
+
+		UploadStream(
+			std::shared_ptr<VulkanContext> context,
+			uint32_t frames
+		);
+		~UploadStream() = default;
+		UploadStream(const UploadStream& other) = delete;
+		UploadStream(UploadStream&& other) noexcept = delete;
+		UploadStream& operator=(const UploadStream& other) = delete;
+		UploadStream& operator=(UploadStream&& other) noexcept = delete;
+
+		// Stages the data and queues a copy into the destination buffer for the next frame.
+		// Any previous contents of the destination buffer are discarded.
+		void copyToBuffer(
+			const void* data,
+			uint32_t size,
+			const std::shared_ptr<VulkanBuffer>& dst,
+			uint32_t dstOffset
+		);
+
+		// Queues a copy from a host-written buffer for the next frame, keeping both buffers alive until it completes.
+		// Any previous contents of the destination buffer are discarded.
+		void copyBuffer(
+			const std::shared_ptr<VulkanBuffer>& src,
+			uint32_t srcOffset,
+			const std::shared_ptr<VulkanBuffer>& dst,
+			uint32_t dstOffset,
+			uint32_t size
+		);
+
+		// Stages the given regions of the data and queues copies of them into the buffer for the next frame,
+		// preserving the rest of its contents. Source offsets are relative to the data.
+		void copyRegionsToBuffer(
+			const uint8_t* data,
+			const std::vector<vk::BufferCopy>& regions,
+			const std::shared_ptr<VulkanBuffer>& dst
+		);
+
+		// Queues copies between regions of device buffers for the next frame, preserving the rest of the destination.
+		void copyBufferRegions(
+			const std::shared_ptr<VulkanBuffer>& src,
+			const std::shared_ptr<VulkanBuffer>& dst,
+			std::vector<vk::BufferCopy> regions
+		);
+
+		// Stages the data and queues copies from it into a newly created image for the next frame,
+		// keeping the resources alive until it completes. The image is moved into the transfer
+		// destination layout before the copies, and into its final layout after.
+		void copyToImage(
+			const void* data,
+			uint32_t size,
+			CopyCommand copy,
+			std::vector<std::shared_ptr<void>> resources,
+			ImageUpload image
+		);
+
+		// Same as copyToImage, but as a separate submission that the frame does not wait on.
+		// The callback is invoked from the render thread once the submission has completed.
+		void copyToImageAsync(
+			const void* data,
+			uint32_t size,
+			CopyCommand copy,
+			std::vector<std::shared_ptr<void>> resources,
+			ImageUpload image,
+			std::function<void()> onComplete
+		);
+
+		// Queues a copy of the data into a region of an image that is in use, for the next frame. The copy is ordered
+		// after any earlier reads of the image, which is expected to be in the given layout outside of it.
+		// All of a frame's writes to an image are staged together and copied with a single command,
+		// unless they partially overlap an earlier write. Earlier writes that are fully covered are dropped.
+		void copyToImageRegion(
+			const void* data,
+			uint32_t size,
+			const std::shared_ptr<VulkanImage>& dst,
+			vk::ImageAspectFlags aspectFlags,
+			vk::ImageLayout layout,
+			const vk::ImageSubresourceLayers& subresource,
+			vk::Offset3D offset,
+			vk::Extent3D extent
+		);
+
+		// Queues arbitrary commands for the next frame's graphics command buffer, keeping the resources alive until it completes.
+		void enqueue(
+			std::function<void(const vk::CommandBuffer&)> commands,
+			std::vector<std::shared_ptr<void>> resources
+		);
+
+		// Keeps a resource alive until the next recorded frame has finished executing.
+		void retain(std::shared_ptr<void> resource);
+
+		// Records all queued uploads into the frame's command buffer, ahead of any rendering.
+		// Returns the semaphore the frame's submission must wait on, if uploads went to the transfer queue.
+		[[nodiscard]] vk::Semaphore record(const vk::CommandBuffer& cmd, uint32_t frame);
+		// Submits all queued asynchronous uploads.
+		void submit();
+		// Releases everything used by the frame. Must only be called once its fence has signaled.
+		void retire(uint32_t frame);
+		// Completes all asynchronous uploads that have finished executing.
+		void poll();
+		// Releases all frames and resizes. Must only be called while the device is idle.
+		void reset(uint32_t frames);
+
+		[[nodiscard]] render::StagingStats getStagingStats();
+
+		[[nodiscard]] static vk::PipelineStageFlags getWaitStages();
+
+	private:
+		struct TransferBatch
+		{
+			std::vector<std::function<void(const vk::CommandBuffer&)>> commands;
+			std::vector<vk::Buffer> buffers;
+			std::vector<ImageUpload> images;
+
+			[[nodiscard]] bool empty() const
+			{
+				return commands.empty();
+			}
+		};
+
+		struct ImageWriteBatch
+		{
+			std::shared_ptr<VulkanImage> image;
+			vk::ImageAspectFlags aspectFlags;
+			vk::ImageLayout layout;
+			std::vector<uint8_t> data;
+			std::vector<vk::BufferImageCopy> regions;
+		};
+
+		struct AsyncUpload
+		{
+			TransferBatch batch;
+			std::vector<std::shared_ptr<void>> resources;
+			std::function<void()> onComplete;
+			util::StagingResource<vk::CommandBuffer> transferCommandBuffer;
+			util::StagingResource<vk::CommandBuffer> commandBuffer;
+			util::StagingResource<vk::Semaphore> semaphore;
+			util::StagingResource<vk::Fence> fence;
+		};
+
+		void queueBufferCopy(
+			VulkanBuffer* src,
+			uint32_t srcOffset,
+			const std::shared_ptr<VulkanBuffer>& dst,
+			uint32_t dstOffset,
+			uint32_t size
+		);
+		void flushImageWrites();
+		void recordTransfer(const vk::CommandBuffer& cmd, const TransferBatch& batch) const;
+		void recordAcquire(const vk::CommandBuffer& cmd, const TransferBatch& batch) const;
+		void recordMipGeneration(const vk::CommandBuffer& cmd, const ImageUpload& image) const;
+
+		std::shared_ptr<VulkanContext> m_context;
+		const bool m_dedicatedTransfer;
+
+		std::mutex m_lock;
+		StagingBelt m_stagingBelt;
+		TransferBatch m_transfers;
+		std::vector<std::function<void(const vk::CommandBuffer&)>> m_commands;
+		std::vector<ImageWriteBatch> m_imageWrites;
+		std::vector<std::shared_ptr<void>> m_pendingResources;
+		std::vector<std::vector<std::shared_ptr<void>>> m_frameResources;
+		util::StagingResource<vk::CommandBuffer> m_transferCommandBuffers;
+		util::StagingResource<vk::Semaphore> m_transferSemaphores;
+		std::vector<AsyncUpload> m_pendingUploads;
+		std::vector<AsyncUpload> m_submittedUploads;
+	};
+}
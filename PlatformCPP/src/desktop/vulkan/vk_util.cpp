@@ -19,6 +19,7 @@ namespace digbuild::platform::desktop::vulkan::util
 		std::set<uint32_t> set{
 			graphicsFamily.has_value() ? graphicsFamily.value() : 0xFFFFFFFF,
 			presentFamily.has_value() ? presentFamily.value() : 0xFFFFFFFF,
+			transferFamily.has_value() ? transferFamily.value() : 0xFFFFFFFF,
 		};
 		set.erase(0xFFFFFFFF);
 		return set;
@@ -120,6 +121,12 @@ namespace digbuild::platform::desktop::vulkan::util
 			if (device.getSurfaceSupportKHR(i, surface))
 				indices.presentFamily = i;
 
+			// Dedicated transfer families map to the DMA engines, prefer those over async compute ones
+			if ((queueFamily.queueFlags & vk::QueueFlagBits::eTransfer) &&
+				!(queueFamily.queueFlags & vk::QueueFlagBits::eGraphics) &&
+				(!indices.transferFamily.has_value() || !(queueFamily.queueFlags & vk::QueueFlagBits::eCompute)))
+				indices.transferFamily = i;
+
 			i++;
 		}
 
@@ -192,7 +199,8 @@ namespace digbuild::platform::desktop::vulkan::util
 		const vk::PhysicalDevice& physicalDevice,
 		const QueueFamilyIndices& familyIndices,
 		const std::vector<const char*>& requiredLayers,
-		const std::vector<const char*>& requiredExtensions
+		const std::vector<const char*>& requiredExtensions,
+		const vk::PhysicalDeviceFeatures& features
 	)
 	{
 		auto uniqueFamilyIndices = familyIndices.asSet();
@@ -202,13 +210,12 @@ namespace digbuild::platform::desktop::vulkan::util
 		for (auto index : uniqueFamilyIndices)
 			deviceQueueCreateInfos.push_back(vk::DeviceQueueCreateInfo({}, index, 1, &queuePriority));
 
-		vk::PhysicalDeviceFeatures deviceFeatures;
 		vk::DeviceCreateInfo deviceCreateInfo(
 			{},
 			deviceQueueCreateInfos,
 			requiredLayers,
 			requiredExtensions,
-			&deviceFeatures
+			&features
 		);
 		vk::PhysicalDeviceExtendedDynamicStateFeaturesEXT ext1{ true };
 		deviceCreateInfo.setPNext(&ext1);
@@ -396,13 +403,14 @@ namespace digbuild::platform::desktop::vulkan::util
 	void copyBufferToImage(
 		const vk::CommandBuffer& cmd,
 		const vk::Buffer& buffer,
+		const uint32_t bufferOffset,
 		const vk::Image& image,
 		const uint32_t width,
 		const uint32_t height
 	)
 	{
 		cmd.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, {{
-			0, width, height,
+			bufferOffset, 0, 0,
 			{ vk::ImageAspectFlagBits::eColor, 0, 0, 1 },
 			{ 0, 0, 0 },
 			{ width, height, 1}
@@ -423,7 +431,7 @@ namespace digbuild::platform::desktop::vulkan::util
 			device, commandPool, graphicsQueue,
 			[&](vk::CommandBuffer& cmd)
 			{
-				copyBufferToImage(cmd, buffer, image, width, height);
+				copyBufferToImage(cmd, buffer, 0, image, width, height);
 			}
 		);
 	}
@@ -438,11 +446,58 @@ namespace digbuild::platform::desktop::vulkan::util
 			return vk::Format::eB8G8R8A8Srgb;
 		case render::TextureFormat::R32G32B32A32S:
 			return vk::Format::eR32G32B32A32Sfloat;
+		case render::TextureFormat::BC1_RGBA_UNORM:
+			return vk::Format::eBc1RgbaUnormBlock;
+		case render::TextureFormat::BC1_RGBA_SRGB:
+			return vk::Format::eBc1RgbaSrgbBlock;
+		case render::TextureFormat::BC3_UNORM:
+			return vk::Format::eBc3UnormBlock;
+		case render::TextureFormat::BC3_SRGB:
+			return vk::Format::eBc3SrgbBlock;
+		case render::TextureFormat::BC4_UNORM:
+			return vk::Format::eBc4UnormBlock;
+		case render::TextureFormat::BC5_UNORM:
+			return vk::Format::eBc5UnormBlock;
+		case render::TextureFormat::BC7_UNORM:
+			return vk::Format::eBc7UnormBlock;
+		case render::TextureFormat::BC7_SRGB:
+			return vk::Format::eBc7SrgbBlock;
+		case render::TextureFormat::R8_UNORM:
+			return vk::Format::eR8Unorm;
+		case render::TextureFormat::R8G8_UNORM:
+			return vk::Format::eR8G8Unorm;
+		case render::TextureFormat::R16_SFLOAT:
+			return vk::Format::eR16Sfloat;
+		case render::TextureFormat::R16G16B16A16_SFLOAT:
+			return vk::Format::eR16G16B16A16Sfloat;
+		case render::TextureFormat::B10G11R11_UFLOAT:
+			return vk::Format::eB10G11R11UfloatPack32;
+		case render::TextureFormat::D16_UNORM:
+			return vk::Format::eD16Unorm;
+		case render::TextureFormat::D24_UNORM_S8_UINT:
+			return vk::Format::eD24UnormS8Uint;
 		case render::TextureFormat::D32SFLOAT_S8UINT:
 			return vk::Format::eD32SfloatS8Uint;
 		}
 		throw std::runtime_error("Invalid type.");
 	}
+
+	vk::ImageAspectFlags getAspectFlags(const render::TextureFormat format)
+	{
+		if (!render::isDepthFormat(format))
+			return vk::ImageAspectFlagBits::eColor;
+		if (!render::hasStencil(format))
+			return vk::ImageAspectFlagBits::eDepth;
+		return vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
+	}
+
+	vk::FormatFeatureFlags getAttachmentFormatFeatures(const render::TextureFormat format)
+	{
+		// Framebuffer attachments are always sampled by later passes as well
+		if (render::isDepthFormat(format))
+			return vk::FormatFeatureFlagBits::eDepthStencilAttachment | vk::FormatFeatureFlagBits::eSampledImage;
+		return vk::FormatFeatureFlagBits::eColorAttachment | vk::FormatFeatureFlagBits::eSampledImage;
+	}
 	
 	uint32_t findMemoryType(const vk::PhysicalDevice& device, const uint32_t memoryTypeBits, const vk::MemoryPropertyFlags memoryProperties)
 	{
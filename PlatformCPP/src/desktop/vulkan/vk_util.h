@@ -12,6 +12,7 @@ namespace digbuild::platform::desktop::vulkan::util
 	{
 		std::optional<uint32_t> graphicsFamily;
 		std::optional<uint32_t> presentFamily;
+		std::optional<uint32_t> transferFamily;
 
 		[[nodiscard]] bool isComplete() const;
 		[[nodiscard]] std::set<uint32_t> asSet() const;
@@ -75,7 +76,8 @@ namespace digbuild::platform::desktop::vulkan::util
 		const vk::PhysicalDevice& physicalDevice,
 		const QueueFamilyIndices& familyIndices,
 		const std::vector<const char*>& requiredLayers,
-		const std::vector<const char*>& requiredExtensions
+		const std::vector<const char*>& requiredExtensions,
+		const vk::PhysicalDeviceFeatures& features
 	);
 
 	[[nodiscard]] vk::UniqueCommandPool createCommandPool(const vk::Device& device, uint32_t graphicsFamily);
@@ -124,6 +126,7 @@ namespace digbuild::platform::desktop::vulkan::util
 	void copyBufferToImage(
 		const vk::CommandBuffer& cmd,
 		const vk::Buffer& buffer,
+		uint32_t bufferOffset,
 		const vk::Image& image,
 		uint32_t width,
 		uint32_t height
@@ -140,6 +143,8 @@ namespace digbuild::platform::desktop::vulkan::util
 	);
 
 	[[nodiscard]] vk::Format toVulkanFormat(render::TextureFormat format);
+	[[nodiscard]] vk::ImageAspectFlags getAspectFlags(render::TextureFormat format);
+	[[nodiscard]] vk::FormatFeatureFlags getAttachmentFormatFeatures(render::TextureFormat format);
 
 	[[nodiscard]] uint32_t findMemoryType(const vk::PhysicalDevice& device, uint32_t memoryTypeBits, vk::MemoryPropertyFlags memoryProperties);
 }
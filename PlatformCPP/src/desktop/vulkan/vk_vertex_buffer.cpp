@@ -1,50 +1,53 @@
 ﻿#include "vk_vertex_buffer.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace digbuild::platform::desktop::vulkan
 {
 	StaticVertexBuffer::StaticVertexBuffer(
-		std::shared_ptr<VulkanContext> context,
+		std::shared_ptr<UploadStream> uploadStream,
+		const std::shared_ptr<GeometryArena>& arena,
 		const std::vector<uint8_t>& data,
 		const uint32_t vertexSize
 	) :
-		m_context(std::move(context)),
+		VertexBuffer(VertexBufferKind::STATIC),
+		m_uploadStream(std::move(uploadStream)),
 		m_vertexSize(vertexSize)
 	{
-		m_buffer = m_context->createBuffer(
-			static_cast<uint32_t>(data.size()),
-			vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
-			vk::SharingMode::eExclusive,
-			{}
-		);
-		
-		auto buf = m_context->createCpuToGpuTransferBuffer(
-			data.data(),
-			static_cast<uint32_t>(data.size())
-		);
+		const auto size = static_cast<uint32_t>(data.size());
+		m_allocation = arena->allocate(size);
 
-		util::copyBufferToBufferImmediate(
-			*m_context->m_device,
-			*m_context->m_commandPool,
-			m_context->m_graphicsQueue,
-			buf->buffer(),
-			m_buffer->buffer(),
-			static_cast<uint32_t>(data.size())
+		// The rest of the page belongs to other geometry, so the upload has to preserve it
+		m_uploadStream->copyRegionsToBuffer(
+			data.data(),
+			{ vk::BufferCopy{ 0, m_allocation->offset(), size } },
+			m_allocation->buffer()
 		);
 		
-		m_size = static_cast<uint32_t>(data.size() / vertexSize);
+		m_size = size / vertexSize;
+	}
+
+	StaticVertexBuffer::~StaticVertexBuffer()
+	{
+		m_uploadStream->retain(std::move(m_allocation));
 	}
 
 	DynamicVertexBuffer::DynamicVertexBuffer(
 		std::shared_ptr<VulkanContext> context,
+		std::shared_ptr<UploadStream> uploadStream,
 		const std::vector<uint8_t>& data,
 		const uint32_t vertexSize,
 		const uint32_t stages
 	) :
+		VertexBuffer(VertexBufferKind::DYNAMIC),
 		m_context(std::move(context)),
+		m_uploadStream(std::move(uploadStream)),
 		m_vertexSize(vertexSize)
 	{
 		m_buffers.resize(stages);
 		m_sizes.resize(stages);
+		m_dirtyRanges.resize(stages);
 
 		if (!data.empty())
 			write(data);
@@ -52,43 +55,139 @@ namespace digbuild::platform::desktop::vulkan
 
 	void DynamicVertexBuffer::tick()
 	{
+		flushPatch();
+		m_patchRanges.clear();
 		advanceIfNeeded();
+
+		uint32_t capacity = 0, used = 0;
+		for (auto i = 0u; i < m_buffers.size(); ++i)
+		{
+			if (m_buffers[i])
+				capacity = std::max(capacity, m_buffers[i]->size());
+			used = std::max(used, m_sizes[i] * m_vertexSize);
+		}
+		m_capacity.tick(capacity, used);
 	}
 
 	void DynamicVertexBuffer::write(const std::vector<uint8_t>& data)
 	{
-		const auto writeIndex = getWriteIndex();
-		auto& buffer = m_buffers[writeIndex];
+		const auto size = static_cast<uint32_t>(data.size());
+		const auto& target = prepareWrite(size);
+		if (target->isDirect())
+			memcpy(target->mappedMemory(), data.data(), size);
+		else
+			m_uploadStream->copyToBuffer(data.data(), size, target, 0);
+	}
+
+	void DynamicVertexBuffer::writeRange(const uint32_t offset, const std::vector<uint8_t>& data)
+	{
+		const auto index = getWriteIndex();
+		const auto current = m_advanceIndex ? index : m_readIndex;
+		const auto byteOffset = offset * m_vertexSize;
+		const auto byteSize = static_cast<uint32_t>(data.size());
+		const auto totalSize = m_sizes[current] * m_vertexSize;
 
-		if (!buffer || buffer->size() < data.size())
+		if (byteOffset + byteSize > totalSize)
+			throw std::runtime_error("Range exceeds the size of the vertex buffer.");
+
+		// The previous target was already handed out this frame, so it is queued now. Its pending ranges
+		// stay in the patch, as the new target is caught up from the same source.
+		if (m_patchIndex && *m_patchIndex != index)
+			flushPatch();
+
+		if (!m_patchIndex)
 		{
-			buffer = m_context->createBuffer(
-				static_cast<uint32_t>(data.size()),
-				vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
-				vk::SharingMode::eExclusive,
-				{}
-			);
-		}
-		
-		auto buf = m_context->createCpuToGpuTransferBuffer(
-			data.data(),
-			static_cast<uint32_t>(data.size())
-		);
+			if (m_patchRanges.empty())
+				m_patchSource = current;
 
-		util::copyBufferToBufferImmediate(
-			*m_context->m_device,
-			*m_context->m_commandPool,
-			m_context->m_graphicsQueue,
-			buf->buffer(),
-			buffer->buffer(),
-			static_cast<uint32_t>(data.size())
-		);
+			if (current != index)
+			{
+				const auto* previous = m_buffers[index].get();
+				if (reserve(totalSize).get() != previous)
+				{
+					m_dirtyRanges[index].clear();
+					m_dirtyRanges[index].add(0, totalSize);
+				}
+				m_sizes[index] = m_sizes[current];
+			}
+
+			m_patchIndex = index;
+		}
 
-		m_sizes[writeIndex] = static_cast<uint32_t>(data.size() / m_vertexSize);
+		if (m_patchData.size() < totalSize)
+			m_patchData.resize(totalSize);
+		memcpy(m_patchData.data() + byteOffset, data.data(), byteSize);
+		m_patchRanges.add(byteOffset, byteSize);
 
 		m_advanceIndex = true;
 	}
+
+	void* DynamicVertexBuffer::map(const uint32_t size)
+	{
+		if (m_mappedBuffer && m_mappedBuffer->size() >= size)
+			return m_mappedBuffer->mappedMemory();
+
+		// The next stage is not being read by any frame in flight, so it can be written in place when the host can reach it
+		if (const auto& target = reserve(size); target->isDirect())
+		{
+			m_mappedBuffer = target;
+			return m_mappedBuffer->mappedMemory();
+		}
+
+		// Staging buffers are only referenced by the upload stream while a copy from them is in flight
+		m_mappedBuffer = nullptr;
+		for (auto& staging : m_stagingBuffers)
+		{
+			if (staging.use_count() != 1)
+				continue;
+			if (staging->size() < size)
+				staging = m_context->createMappedBuffer(size, vk::BufferUsageFlagBits::eTransferSrc);
+			m_mappedBuffer = staging;
+			break;
+		}
+		if (!m_mappedBuffer)
+		{
+			m_mappedBuffer = m_context->createMappedBuffer(size, vk::BufferUsageFlagBits::eTransferSrc);
+			m_stagingBuffers.push_back(m_mappedBuffer);
+		}
+
+		return m_mappedBuffer->mappedMemory();
+	}
+
+	void DynamicVertexBuffer::commit(const uint32_t size)
+	{
+		if (!m_mappedBuffer)
+			throw std::runtime_error("Vertex buffer must be mapped before committing.");
+		if (size > m_mappedBuffer->size())
+			throw std::runtime_error("Committed size exceeds the mapped size.");
+
+		// Mapped stages only need copying if committing a smaller size made them shrink
+		if (const auto& target = prepareWrite(size); target != m_mappedBuffer)
+			m_uploadStream->copyBuffer(m_mappedBuffer, 0, target, 0, size);
+		m_mappedBuffer = nullptr;
+	}
 	
+	void DynamicVertexBuffer::setCapacityPolicy(const render::BufferCapacityPolicy& policy)
+	{
+		m_capacity.setPolicy(policy);
+	}
+
+	render::BufferStats DynamicVertexBuffer::getStats()
+	{
+		render::BufferStats stats{ 0, 0, m_capacity.getReallocations(), 0 };
+		for (auto i = 0u; i < m_buffers.size(); ++i)
+		{
+			if (m_buffers[i])
+			{
+				stats.capacity += m_buffers[i]->size();
+				if (m_buffers[i]->isDirect())
+					stats.directCapacity += m_buffers[i]->size();
+			}
+			stats.used += m_sizes[i] * m_vertexSize;
+		}
+		return stats;
+	}
+
 	vk::Buffer& DynamicVertexBuffer::get()
 	{
 		advanceIfNeeded();
@@ -114,4 +213,107 @@ namespace digbuild::platform::desktop::vulkan
 	{
 		return (m_readIndex + 1) % m_buffers.size();
 	}
+
+	std::shared_ptr<VulkanBuffer>& DynamicVertexBuffer::reserve(const uint32_t size)
+	{
+		auto& buffer = m_buffers[getWriteIndex()];
+		const auto capacity = buffer ? buffer->size() : 0;
+		const auto newCapacity = m_capacity.fit(capacity, size);
+		if (!buffer || newCapacity != capacity)
+		{
+			if (buffer)
+				m_uploadStream->retain(std::move(buffer));
+			m_capacity.reallocated();
+			buffer = createBuffer(newCapacity);
+		}
+		return buffer;
+	}
+
+	std::shared_ptr<VulkanBuffer> DynamicVertexBuffer::createBuffer(const uint32_t size) const
+	{
+		constexpr vk::BufferUsageFlags usage =
+			vk::BufferUsageFlagBits::eVertexBuffer |
+			vk::BufferUsageFlagBits::eIndexBuffer |
+			vk::BufferUsageFlagBits::eIndirectBuffer |
+			vk::BufferUsageFlagBits::eTransferSrc |
+			vk::BufferUsageFlagBits::eTransferDst;
+
+		// Stages in host-visible device memory skip staging, anything else is written through the upload stream
+		if (auto buffer = m_context->createDirectBuffer(size, usage))
+			return buffer;
+		return m_context->createBuffer(size, usage, vk::SharingMode::eExclusive, {});
+	}
+
+	std::shared_ptr<VulkanBuffer>& DynamicVertexBuffer::prepareWrite(const uint32_t size)
+	{
+		const auto index = getWriteIndex();
+
+		// A full write replaces any range writes to the same stage, but earlier targets still need theirs
+		if (m_patchIndex && *m_patchIndex != index)
+			flushPatch();
+		m_patchRanges.clear();
+		m_patchIndex.reset();
+
+		for (auto i = 0u; i < m_dirtyRanges.size(); ++i)
+		{
+			m_dirtyRanges[i].clear();
+			if (i != index)
+				m_dirtyRanges[i].add(0, size);
+		}
+
+		m_sizes[index] = size / m_vertexSize;
+		m_advanceIndex = true;
+
+		return reserve(size);
+	}
+
+	void DynamicVertexBuffer::flushPatch()
+	{
+		if (!m_patchIndex)
+			return;
+
+		const auto target = *m_patchIndex;
+		const auto totalSize = m_sizes[target] * m_vertexSize;
+		auto& dirty = m_dirtyRanges[target];
+
+		// Catch up on everything that changed since this stage was last written, except what the patch overwrites
+		for (const auto& [start, end] : m_patchRanges.ranges())
+			dirty.remove(start, end - start);
+		if (m_patchSource != target)
+		{
+			std::vector<vk::BufferCopy> regions;
+			for (const auto& [start, end] : dirty.ranges())
+			{
+				if (start >= totalSize)
+					break;
+				regions.emplace_back(start, start, std::min(end, totalSize) - start);
+			}
+			m_uploadStream->copyBufferRegions(m_buffers[m_patchSource], m_buffers[target], std::move(regions));
+		}
+		dirty.clear();
+
+		// The patch does not overlap the catch-up copy, so a direct stage can take it right away
+		if (m_buffers[target]->isDirect())
+		{
+			for (const auto& [start, end] : m_patchRanges.ranges())
+				memcpy(m_buffers[target]->mappedMemory() + start, m_patchData.data() + start, end - start);
+		}
+		else
+		{
+			std::vector<vk::BufferCopy> regions;
+			for (const auto& [start, end] : m_patchRanges.ranges())
+				regions.emplace_back(start, start, end - start);
+			m_uploadStream->copyRegionsToBuffer(m_patchData.data(), regions, m_buffers[target]);
+		}
+
+		for (auto i = 0u; i < m_dirtyRanges.size(); ++i)
+		{
+			if (i == target)
+				continue;
+			for (const auto& [start, end] : m_patchRanges.ranges())
+				m_dirtyRanges[i].add(start, end - start);
+		}
+
+		m_patchIndex.reset();
+	}
 }
@@ -1,25 +1,54 @@
 ﻿#pragma once
+#include <optional>
+
 #include "vk_buffer.h"
+#include "vk_buffer_capacity.h"
 #include "vk_context.h"
+#include "vk_geometry_arena.h"
+#include "vk_range_allocator.h"
+#include "vk_upload_stream.h"
 #include "../../render/vertex_buffer.h"
 
 namespace digbuild::platform::desktop::vulkan
 {
+	enum class VertexBufferKind : uint8_t
+	{
+		STATIC,
+		DYNAMIC
+	};
+
 	class VertexBuffer : public render::VertexBuffer
 	{
 	public:
+		explicit VertexBuffer(const VertexBufferKind kind) :
+			m_kind(kind)
+		{
+		}
+
+		// Lets command recording tell buffers apart without going through RTTI
+		[[nodiscard]] VertexBufferKind getKind() const
+		{
+			return m_kind;
+		}
+
 		[[nodiscard]] virtual vk::Buffer& get() = 0;
+		[[nodiscard]] virtual uint32_t offset() = 0;
 		[[nodiscard]] virtual uint32_t size() = 0;
+
+	private:
+		const VertexBufferKind m_kind;
 	};
 
 	class StaticVertexBuffer final : public VertexBuffer
 	{
 	public:
 		StaticVertexBuffer(
-			std::shared_ptr<VulkanContext> context,
+			std::shared_ptr<UploadStream> uploadStream,
+			const std::shared_ptr<GeometryArena>& arena,
 			const std::vector<uint8_t>& data,
 			uint32_t vertexSize
 		);
+		~StaticVertexBuffer() override;
 
 		[[nodiscard]] uint32_t getVertexSize() override
 		{
@@ -31,9 +60,38 @@ namespace digbuild::platform::desktop::vulkan
 			throw std::runtime_error("Cannot write to a static vertex buffer.");
 		}
 
+		void writeRange(uint32_t offset, const std::vector<uint8_t>& data) override
+		{
+			throw std::runtime_error("Cannot write to a static vertex buffer.");
+		}
+
+		[[nodiscard]] void* map(uint32_t size) override
+		{
+			throw std::runtime_error("Cannot write to a static vertex buffer.");
+		}
+
+		void commit(uint32_t size) override
+		{
+			throw std::runtime_error("Cannot write to a static vertex buffer.");
+		}
+
+		void setCapacityPolicy(const render::BufferCapacityPolicy& policy) override
+		{
+		}
+
+		[[nodiscard]] render::BufferStats getStats() override
+		{
+			return render::BufferStats{ m_allocation->size(), m_allocation->size(), 0, 0 };
+		}
+
 		[[nodiscard]] vk::Buffer& get() override
 		{
-			return m_buffer->buffer();
+			return m_allocation->buffer()->buffer();
+		}
+
+		[[nodiscard]] uint32_t offset() override
+		{
+			return m_allocation->offset();
 		}
 
 		[[nodiscard]] uint32_t size() override
@@ -42,8 +100,8 @@ namespace digbuild::platform::desktop::vulkan
 		}
 
 	private:
-		std::shared_ptr<VulkanContext> m_context;
-		std::unique_ptr<VulkanBuffer> m_buffer;
+		std::shared_ptr<UploadStream> m_uploadStream;
+		std::shared_ptr<GeometryAllocation> m_allocation;
 		uint32_t m_vertexSize, m_size;
 	};
 
@@ -52,6 +110,7 @@ namespace digbuild::platform::desktop::vulkan
 	public:
 		DynamicVertexBuffer(
 			std::shared_ptr<VulkanContext> context,
+			std::shared_ptr<UploadStream> uploadStream,
 			const std::vector<uint8_t>& data,
 			uint32_t vertexSize,
 			uint32_t stages
@@ -66,17 +125,47 @@ namespace digbuild::platform::desktop::vulkan
 
 		void write(const std::vector<uint8_t>& data) override;
 
+		void writeRange(uint32_t offset, const std::vector<uint8_t>& data) override;
+
+		[[nodiscard]] void* map(uint32_t size) override;
+
+		void commit(uint32_t size) override;
+
+		void setCapacityPolicy(const render::BufferCapacityPolicy& policy) override;
+
+		[[nodiscard]] render::BufferStats getStats() override;
+
 		[[nodiscard]] vk::Buffer& get() override;
 
+		[[nodiscard]] uint32_t offset() override
+		{
+			return 0;
+		}
+
 		[[nodiscard]] uint32_t size() override;
 
 	private:
 		void advanceIfNeeded();
 		uint32_t getWriteIndex() const;
+		[[nodiscard]] std::shared_ptr<VulkanBuffer> createBuffer(uint32_t size) const;
+		std::shared_ptr<VulkanBuffer>& reserve(uint32_t size);
+		std::shared_ptr<VulkanBuffer>& prepareWrite(uint32_t size);
+		void flushPatch();
 
 		std::shared_ptr<VulkanContext> m_context;
-		std::vector<std::unique_ptr<VulkanBuffer>> m_buffers;
+		std::shared_ptr<UploadStream> m_uploadStream;
+		std::vector<std::shared_ptr<VulkanBuffer>> m_buffers;
 		std::vector<uint32_t> m_sizes;
+		util::BufferCapacity m_capacity;
+		std::vector<std::shared_ptr<VulkanBuffer>> m_stagingBuffers;
+		std::shared_ptr<VulkanBuffer> m_mappedBuffer;
+		// Bytes in which each stage differs from the most recently written one
+		std::vector<util::RangeSet> m_dirtyRanges;
+		// Range writes that have yet to be queued, applied on top of the source stage's contents
+		std::vector<uint8_t> m_patchData;
+		util::RangeSet m_patchRanges;
+		std::optional<uint32_t> m_patchIndex;
+		uint32_t m_patchSource = 0;
 		uint32_t m_vertexSize;
 		uint32_t m_readIndex = 0;
 		bool m_advanceIndex = false;
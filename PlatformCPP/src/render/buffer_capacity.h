@@ -0,0 +1,24 @@
+﻿#pragma once
+#include <cstdint>
+
+namespace digbuild::platform::render
+{
+	struct BufferCapacityPolicy
+	{
+		// Factor by which the capacity grows when the contents no longer fit
+		float growthFactor = 1.5f;
+		// Fraction of the capacity below which usage must stay for the buffer to shrink
+		float shrinkThreshold = 0.25f;
+		// Number of consecutive frames usage must stay below the threshold
+		uint32_t shrinkDelay = 120;
+	};
+
+	struct BufferStats
+	{
+		uint64_t capacity;
+		uint64_t used;
+		uint32_t reallocations;
+		// Part of the capacity the host writes to directly, without going through staging memory
+		uint64_t directCapacity;
+	};
+}
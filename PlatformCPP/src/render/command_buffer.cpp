@@ -1,5 +1,6 @@
 ﻿#include "command_buffer.h"
 
+#include <stdexcept>
 
 #include "render_context.h"
 #include "../util/native_handle.h"
@@ -14,7 +15,12 @@ namespace digbuild::platform::render
 		SET_SCISSOR,
 		BIND_UNIFORM,
 		BIND_TEXTURE,
-		DRAW
+		PUSH_CONSTANTS,
+		DRAW,
+		DRAW_INDEXED,
+		DRAW_INDIRECT,
+		DRAW_TRANSIENT,
+		DRAW_INDEXED_TRANSIENT
 	};
 
 	struct CommandBufferCmdSetViewportScissorC
@@ -40,11 +46,51 @@ namespace digbuild::platform::render
 		const util::native_handle pipeline;
 		const util::native_handle binding;
 	};
+	struct CommandBufferCmdPushConstantsC
+	{
+		const util::native_handle pipeline;
+		const uint32_t offset;
+		const uint32_t size;
+		// Where the data starts in the push constant data passed alongside the commands
+		const uint32_t dataOffset;
+	};
 	struct CommandBufferCmdDrawC
 	{
 		const util::native_handle pipeline;
 		const util::native_handle vertexBuffer;
 		const util::native_handle instanceBuffer;
+		const DrawRange range;
+	};
+	struct CommandBufferCmdDrawIndexedC
+	{
+		const util::native_handle pipeline;
+		const util::native_handle vertexBuffer;
+		const util::native_handle indexBuffer;
+		const util::native_handle instanceBuffer;
+		const DrawIndexedRange range;
+	};
+	struct CommandBufferCmdDrawIndirectC
+	{
+		const util::native_handle pipeline;
+		const util::native_handle vertexBuffer;
+		const util::native_handle indexBuffer;
+		const util::native_handle instanceBuffer;
+		const util::native_handle indirectBuffer;
+	};
+	struct CommandBufferCmdDrawTransientC
+	{
+		const util::native_handle pipeline;
+		const TransientVertexRange vertices;
+		const util::native_handle instanceBuffer;
+		const DrawRange range;
+	};
+	struct CommandBufferCmdDrawIndexedTransientC
+	{
+		const util::native_handle pipeline;
+		const TransientVertexRange vertices;
+		const util::native_handle indexBuffer;
+		const util::native_handle instanceBuffer;
+		const DrawIndexedRange range;
 	};
 	
 	struct CommandBufferCmdC
@@ -57,9 +103,29 @@ namespace digbuild::platform::render
 			const CommandBufferCmdSetScissorC cmdSetScissor;
 			const CommandBufferCmdBindUniformC cmdBindUniform;
 			const CommandBufferCmdBindTextureC cmdBindTexture;
+			const CommandBufferCmdPushConstantsC cmdPushConstants;
 			const CommandBufferCmdDrawC cmdDraw;
+			const CommandBufferCmdDrawIndexedC cmdDrawIndexed;
+			const CommandBufferCmdDrawIndirectC cmdDrawIndirect;
+			const CommandBufferCmdDrawTransientC cmdDrawTransient;
+			const CommandBufferCmdDrawIndexedTransientC cmdDrawIndexedTransient;
 		};
 	};
+
+	// Resolves a handle without touching its reference count, unless the command buffer has yet to retain it.
+	// Consecutive commands mostly share their pipeline and buffers, so the last resource is checked first.
+	template<typename T>
+	T* resolve(CommandBuffer* commandBuffer, const util::native_handle handle, const Resource*& last)
+	{
+		if (handle == nullptr)
+			return nullptr;
+
+		auto* resource = util::handle_cast<T>(handle);
+		if (resource != last && !commandBuffer->isRetained(resource))
+			commandBuffer->retain(util::handle_share<T>(handle));
+		last = resource;
+		return resource;
+	}
 }
 
 using namespace digbuild::platform::util;
@@ -70,7 +136,9 @@ extern "C" {
 		RenderContext* context,
 		const native_handle format,
 		const CommandBufferCmdC* commands,
-		const uint32_t commandCount
+		const uint32_t commandCount,
+		const uint8_t* pushConstantData,
+		const uint32_t pushConstantDataSize
 	)
 	{
 		auto* commandBuffer = handle_cast<CommandBuffer>(instance);
@@ -79,6 +147,7 @@ extern "C" {
 			fmt = context->getSurfaceFormat();
 
 		commandBuffer->beginRecording(fmt);
+		const Resource* last = nullptr;
 		for (uint32_t i = 0; i < commandCount; ++i)
 		{
 			const auto& cmd = commands[i];
@@ -86,7 +155,7 @@ extern "C" {
 			{
 			case CommandBufferCmdTypeC::SET_VIEWPORT_SCISSOR:
 				commandBuffer->setViewportAndScissor(
-					handle_share<IRenderTarget>(cmd.cmdSetViewportScissor.target)
+					resolve<IRenderTarget>(commandBuffer, cmd.cmdSetViewportScissor.target, last)
 				);
 				break;
 			case CommandBufferCmdTypeC::SET_VIEWPORT:
@@ -97,22 +166,70 @@ extern "C" {
 				break;
 			case CommandBufferCmdTypeC::BIND_UNIFORM:
 				commandBuffer->bindUniform(
-					handle_share<RenderPipeline>(cmd.cmdBindUniform.pipeline),
-					handle_share<UniformBinding>(cmd.cmdBindUniform.uniformBinding),
+					resolve<RenderPipeline>(commandBuffer, cmd.cmdBindUniform.pipeline, last),
+					resolve<UniformBinding>(commandBuffer, cmd.cmdBindUniform.uniformBinding, last),
 					cmd.cmdBindUniform.binding
 				);
 				break;
 			case CommandBufferCmdTypeC::BIND_TEXTURE:
 				commandBuffer->bindTexture(
-					handle_share<RenderPipeline>(cmd.cmdBindTexture.pipeline),
-					handle_share<TextureBinding>(cmd.cmdBindTexture.binding)
+					resolve<RenderPipeline>(commandBuffer, cmd.cmdBindTexture.pipeline, last),
+					resolve<TextureBinding>(commandBuffer, cmd.cmdBindTexture.binding, last)
+				);
+				break;
+			case CommandBufferCmdTypeC::PUSH_CONSTANTS:
+				if (cmd.cmdPushConstants.size > MAX_PUSH_CONSTANTS_SIZE)
+					throw std::runtime_error("Push constant data exceeds the maximum push constant size.");
+				if (static_cast<uint64_t>(cmd.cmdPushConstants.dataOffset) + cmd.cmdPushConstants.size > pushConstantDataSize)
+					throw std::runtime_error("Push constant data lies outside of the data that was passed in.");
+				commandBuffer->pushConstants(
+					resolve<RenderPipeline>(commandBuffer, cmd.cmdPushConstants.pipeline, last),
+					cmd.cmdPushConstants.offset,
+					pushConstantData + cmd.cmdPushConstants.dataOffset,
+					cmd.cmdPushConstants.size
 				);
 				break;
 			case CommandBufferCmdTypeC::DRAW:
 				commandBuffer->draw(
-					handle_share<RenderPipeline>(cmd.cmdDraw.pipeline),
-					handle_share<VertexBuffer>(cmd.cmdDraw.vertexBuffer),
-					handle_share<VertexBuffer>(cmd.cmdDraw.instanceBuffer)
+					resolve<RenderPipeline>(commandBuffer, cmd.cmdDraw.pipeline, last),
+					resolve<VertexBuffer>(commandBuffer, cmd.cmdDraw.vertexBuffer, last),
+					resolve<VertexBuffer>(commandBuffer, cmd.cmdDraw.instanceBuffer, last),
+					cmd.cmdDraw.range
+				);
+				break;
+			case CommandBufferCmdTypeC::DRAW_INDEXED:
+				commandBuffer->drawIndexed(
+					resolve<RenderPipeline>(commandBuffer, cmd.cmdDrawIndexed.pipeline, last),
+					resolve<VertexBuffer>(commandBuffer, cmd.cmdDrawIndexed.vertexBuffer, last),
+					resolve<IndexBuffer>(commandBuffer, cmd.cmdDrawIndexed.indexBuffer, last),
+					resolve<VertexBuffer>(commandBuffer, cmd.cmdDrawIndexed.instanceBuffer, last),
+					cmd.cmdDrawIndexed.range
+				);
+				break;
+			case CommandBufferCmdTypeC::DRAW_INDIRECT:
+				commandBuffer->drawIndirect(
+					resolve<RenderPipeline>(commandBuffer, cmd.cmdDrawIndirect.pipeline, last),
+					resolve<VertexBuffer>(commandBuffer, cmd.cmdDrawIndirect.vertexBuffer, last),
+					resolve<IndexBuffer>(commandBuffer, cmd.cmdDrawIndirect.indexBuffer, last),
+					resolve<VertexBuffer>(commandBuffer, cmd.cmdDrawIndirect.instanceBuffer, last),
+					resolve<IndirectDrawBuffer>(commandBuffer, cmd.cmdDrawIndirect.indirectBuffer, last)
+				);
+				break;
+			case CommandBufferCmdTypeC::DRAW_TRANSIENT:
+				commandBuffer->drawTransient(
+					resolve<RenderPipeline>(commandBuffer, cmd.cmdDrawTransient.pipeline, last),
+					cmd.cmdDrawTransient.vertices,
+					resolve<VertexBuffer>(commandBuffer, cmd.cmdDrawTransient.instanceBuffer, last),
+					cmd.cmdDrawTransient.range
+				);
+				break;
+			case CommandBufferCmdTypeC::DRAW_INDEXED_TRANSIENT:
+				commandBuffer->drawIndexedTransient(
+					resolve<RenderPipeline>(commandBuffer, cmd.cmdDrawIndexedTransient.pipeline, last),
+					cmd.cmdDrawIndexedTransient.vertices,
+					resolve<IndexBuffer>(commandBuffer, cmd.cmdDrawIndexedTransient.indexBuffer, last),
+					resolve<VertexBuffer>(commandBuffer, cmd.cmdDrawIndexedTransient.instanceBuffer, last),
+					cmd.cmdDrawIndexedTransient.range
 				);
 				break;
 			}
@@ -1,7 +1,10 @@
 ﻿#pragma once
+#include <limits>
 #include <memory>
 
 #include "framebuffer_format.h"
+#include "index_buffer.h"
+#include "indirect_draw_buffer.h"
 #include "render_pipeline.h"
 #include "render_target.h"
 #include "resource.h"
@@ -12,6 +15,37 @@
 
 namespace digbuild::platform::render
 {
+	// Used as a draw count to draw everything from the first element to the end of the buffer
+	constexpr uint32_t DRAW_REMAINING = std::numeric_limits<uint32_t>::max();
+
+	struct DrawRange
+	{
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+		uint32_t firstInstance;
+		uint32_t instanceCount;
+	};
+
+	struct DrawIndexedRange
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		int32_t vertexOffset;
+		uint32_t firstInstance;
+		uint32_t instanceCount;
+	};
+
+	// Vertices allocated for the frame being built, passed around by value so that allocating them creates no
+	// objects. They can only be drawn by command buffers committed in that same frame.
+	struct TransientVertexRange
+	{
+		uint32_t chunk;
+		uint32_t offset;
+		uint32_t size;
+		uint32_t vertexSize;
+		uint64_t frame;
+	};
+
 	class CommandBuffer : public Resource, public std::enable_shared_from_this<CommandBuffer>
 	{
 	public:
@@ -22,23 +56,61 @@ namespace digbuild::platform::render
 		CommandBuffer& operator=(const CommandBuffer& other) = delete;
 		CommandBuffer& operator=(CommandBuffer&& other) noexcept = delete;
 
+		// Commands only keep raw pointers to the resources they use, each of which must be retained once per
+		// recording before it is first referenced. Retained resources are released when no stage needs them.
 		virtual void beginRecording(const std::shared_ptr<FramebufferFormat>& format) = 0;
-		virtual void setViewportAndScissor(std::shared_ptr<IRenderTarget> renderTarget) = 0;
+		[[nodiscard]] virtual bool isRetained(const Resource* resource) const = 0;
+		virtual void retain(std::shared_ptr<Resource> resource) = 0;
+		virtual void setViewportAndScissor(IRenderTarget* renderTarget) = 0;
 		virtual void setViewport(util::Extents2D extents) = 0;
 		virtual void setScissor(util::Extents2D extents) = 0;
 		virtual void bindUniform(
-			std::shared_ptr<RenderPipeline> pipeline,
-			std::shared_ptr<UniformBinding> uniformBinding,
+			RenderPipeline* pipeline,
+			UniformBinding* uniformBinding,
 			uint32_t binding
 		) = 0;
 		virtual void bindTexture(
-			std::shared_ptr<RenderPipeline> pipeline,
-			std::shared_ptr<TextureBinding> binding
+			RenderPipeline* pipeline,
+			TextureBinding* binding
+		) = 0;
+		virtual void pushConstants(
+			RenderPipeline* pipeline,
+			uint32_t offset,
+			const uint8_t* data,
+			uint32_t size
 		) = 0;
 		virtual void draw(
-			std::shared_ptr<RenderPipeline> pipeline,
-			std::shared_ptr<VertexBuffer> vertexBuffer,
-			std::shared_ptr<VertexBuffer> instanceBuffer
+			RenderPipeline* pipeline,
+			VertexBuffer* vertexBuffer,
+			VertexBuffer* instanceBuffer,
+			DrawRange range
+		) = 0;
+		virtual void drawIndexed(
+			RenderPipeline* pipeline,
+			VertexBuffer* vertexBuffer,
+			IndexBuffer* indexBuffer,
+			VertexBuffer* instanceBuffer,
+			DrawIndexedRange range
+		) = 0;
+		virtual void drawTransient(
+			RenderPipeline* pipeline,
+			const TransientVertexRange& vertices,
+			VertexBuffer* instanceBuffer,
+			DrawRange range
+		) = 0;
+		virtual void drawIndexedTransient(
+			RenderPipeline* pipeline,
+			const TransientVertexRange& vertices,
+			IndexBuffer* indexBuffer,
+			VertexBuffer* instanceBuffer,
+			DrawIndexedRange range
+		) = 0;
+		virtual void drawIndirect(
+			RenderPipeline* pipeline,
+			VertexBuffer* vertexBuffer,
+			IndexBuffer* indexBuffer,
+			VertexBuffer* instanceBuffer,
+			IndirectDrawBuffer* indirectBuffer
 		) = 0;
 		virtual void finishRecording() = 0;
 	};
@@ -0,0 +1,66 @@
+﻿#include "index_buffer.h"
+
+#include <vector>
+
+#include "../util/native_handle.h"
+#include "../util/utils.h"
+
+using namespace digbuild::platform::util;
+using namespace digbuild::platform::render;
+extern "C"
+{
+	DLLEXPORT void dbp_index_buffer_write(
+		const native_handle instance,
+		const uint8_t* data,
+		const uint32_t indexCount
+	)
+	{
+		auto buf = handle_cast<IndexBuffer>(instance);
+		buf->write(std::vector(data, data + (indexCount * getIndexSize(buf->getIndexType()))));
+	}
+
+	DLLEXPORT void dbp_index_buffer_write_range(
+		const native_handle instance,
+		const uint32_t offset,
+		const uint8_t* data,
+		const uint32_t indexCount
+	)
+	{
+		auto buf = handle_cast<IndexBuffer>(instance);
+		buf->writeRange(offset, std::vector(data, data + (indexCount * getIndexSize(buf->getIndexType()))));
+	}
+
+	DLLEXPORT void* dbp_index_buffer_map(
+		const native_handle instance,
+		const uint32_t indexCount
+	)
+	{
+		auto buf = handle_cast<IndexBuffer>(instance);
+		return buf->map(indexCount * getIndexSize(buf->getIndexType()));
+	}
+
+	DLLEXPORT void dbp_index_buffer_commit(
+		const native_handle instance,
+		const uint32_t indexCount
+	)
+	{
+		auto buf = handle_cast<IndexBuffer>(instance);
+		buf->commit(indexCount * getIndexSize(buf->getIndexType()));
+	}
+
+	DLLEXPORT void dbp_index_buffer_set_capacity_policy(
+		const native_handle instance,
+		const BufferCapacityPolicy* policy
+	)
+	{
+		handle_cast<IndexBuffer>(instance)->setCapacityPolicy(*policy);
+	}
+
+	DLLEXPORT void dbp_index_buffer_get_stats(
+		const native_handle instance,
+		BufferStats* stats
+	)
+	{
+		*stats = handle_cast<IndexBuffer>(instance)->getStats();
+	}
+}
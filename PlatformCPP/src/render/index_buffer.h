@@ -0,0 +1,44 @@
+﻿#pragma once
+#include <memory>
+#include <vector>
+
+#include "buffer_capacity.h"
+#include "resource.h"
+
+namespace digbuild::platform::render
+{
+	enum class IndexType : uint8_t
+	{
+		UINT16,
+		UINT32
+	};
+	
+	inline uint32_t getIndexSize(const IndexType type)
+	{
+		return type == IndexType::UINT16 ? 2 : 4;
+	}
+
+	class IndexBuffer : public Resource, public std::enable_shared_from_this<IndexBuffer>
+	{
+	public:
+		IndexBuffer() = default;
+		~IndexBuffer() override = default;
+		IndexBuffer(const IndexBuffer& other) = delete;
+		IndexBuffer(IndexBuffer&& other) noexcept = delete;
+		IndexBuffer& operator=(const IndexBuffer& other) = delete;
+		IndexBuffer& operator=(IndexBuffer&& other) noexcept = delete;
+
+		[[nodiscard]] virtual IndexType getIndexType() = 0;
+		
+		virtual void write(const std::vector<uint8_t>& data) = 0;
+		// Overwrites part of the contents, starting at the given index.
+		virtual void writeRange(uint32_t offset, const std::vector<uint8_t>& data) = 0;
+
+		// Returns writable memory for the given number of bytes, which replaces the contents once committed.
+		[[nodiscard]] virtual void* map(uint32_t size) = 0;
+		virtual void commit(uint32_t size) = 0;
+
+		virtual void setCapacityPolicy(const BufferCapacityPolicy& policy) = 0;
+		[[nodiscard]] virtual BufferStats getStats() = 0;
+	};
+}
@@ -0,0 +1,56 @@
+﻿#include "indirect_draw_buffer.h"
+
+#include <vector>
+
+#include "../util/native_handle.h"
+#include "../util/utils.h"
+
+using namespace digbuild::platform::util;
+using namespace digbuild::platform::render;
+extern "C"
+{
+	DLLEXPORT void dbp_indirect_draw_buffer_write(
+		const native_handle instance,
+		const uint8_t* data,
+		const uint32_t commandCount
+	)
+	{
+		auto buf = handle_cast<IndirectDrawBuffer>(instance);
+		buf->write(std::vector(data, data + (commandCount * buf->getCommandSize())));
+	}
+
+	DLLEXPORT void dbp_indirect_draw_buffer_write_range(
+		const native_handle instance,
+		const uint32_t offset,
+		const uint8_t* data,
+		const uint32_t commandCount
+	)
+	{
+		auto buf = handle_cast<IndirectDrawBuffer>(instance);
+		buf->writeRange(offset, std::vector(data, data + (commandCount * buf->getCommandSize())));
+	}
+
+	DLLEXPORT void dbp_indirect_draw_buffer_set_draw_count(
+		const native_handle instance,
+		const uint32_t drawCount
+	)
+	{
+		handle_cast<IndirectDrawBuffer>(instance)->setDrawCount(drawCount);
+	}
+
+	DLLEXPORT void dbp_indirect_draw_buffer_set_capacity_policy(
+		const native_handle instance,
+		const BufferCapacityPolicy* policy
+	)
+	{
+		handle_cast<IndirectDrawBuffer>(instance)->setCapacityPolicy(*policy);
+	}
+
+	DLLEXPORT void dbp_indirect_draw_buffer_get_stats(
+		const native_handle instance,
+		BufferStats* stats
+	)
+	{
+		*stats = handle_cast<IndirectDrawBuffer>(instance)->getStats();
+	}
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+#include <memory>
+#include <vector>
+
+#include "buffer_capacity.h"
+#include "resource.h"
+
+namespace digbuild::platform::render
+{
+	// Matches VkDrawIndirectCommand
+	struct DrawIndirectCommand
+	{
+		uint32_t vertexCount;
+		uint32_t instanceCount;
+		uint32_t firstVertex;
+		uint32_t firstInstance;
+	};
+
+	// Matches VkDrawIndexedIndirectCommand
+	struct DrawIndexedIndirectCommand
+	{
+		uint32_t indexCount;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t vertexOffset;
+		uint32_t firstInstance;
+	};
+
+	class IndirectDrawBuffer : public Resource, public std::enable_shared_from_this<IndirectDrawBuffer>
+	{
+	public:
+		IndirectDrawBuffer() = default;
+		~IndirectDrawBuffer() override = default;
+		IndirectDrawBuffer(const IndirectDrawBuffer& other) = delete;
+		IndirectDrawBuffer(IndirectDrawBuffer&& other) noexcept = delete;
+		IndirectDrawBuffer& operator=(const IndirectDrawBuffer& other) = delete;
+		IndirectDrawBuffer& operator=(IndirectDrawBuffer&& other) noexcept = delete;
+
+		[[nodiscard]] virtual bool isIndexed() = 0;
+
+		[[nodiscard]] uint32_t getCommandSize()
+		{
+			return isIndexed() ? sizeof(DrawIndexedIndirectCommand) : sizeof(DrawIndirectCommand);
+		}
+
+		// Replaces all draw commands, and draws all of them.
+		virtual void write(const std::vector<uint8_t>& data) = 0;
+		// Overwrites some of the draw commands, starting at the given one.
+		virtual void writeRange(uint32_t offset, const std::vector<uint8_t>& data) = 0;
+		// Limits drawing to the first commands, without rewriting them.
+		virtual void setDrawCount(uint32_t drawCount) = 0;
+
+		virtual void setCapacityPolicy(const BufferCapacityPolicy& policy) = 0;
+		[[nodiscard]] virtual BufferStats getStats() = 0;
+	};
+}
@@ -1,5 +1,6 @@
 ﻿#include "render_context.h"
 
+#include <limits>
 #include <stdexcept>
 
 #include "../util/native_handle.h"
@@ -34,6 +35,17 @@ namespace digbuild::platform::render
 			return 4 * sizeof(float);
 		case NumericType::FLOAT4X4:
 			return 4 * 4 * sizeof(float);
+		case NumericType::HALF2:
+			return 2 * sizeof(uint16_t);
+		case NumericType::HALF4:
+			return 4 * sizeof(uint16_t);
+		case NumericType::SNORM8X4:
+		case NumericType::UNORM8X4:
+			return 4 * sizeof(uint8_t);
+		case NumericType::UNORM16X2:
+			return 2 * sizeof(uint16_t);
+		case NumericType::A2B10G10R10:
+			return sizeof(uint32_t);
 		}
 		throw std::runtime_error("Invalid type.");
 	}
@@ -331,6 +343,8 @@ extern "C" {
 		const BlendOptionsC* blendOptions,
 		const native_handle vertexShader,
 		const native_handle fragmentShader,
+		const PushConstantRange* pushConstants,
+		const uint32_t pushConstantCount,
 
 		const Topology topology,
 		const RasterMode rasterMode,
@@ -377,7 +391,8 @@ extern "C" {
 					hasCullingMode ? std::make_optional(cullingMode) : std::optional<CullingMode>{},
 					hasFrontFace ? std::make_optional(frontFace) : std::optional<FrontFace>{}
 				},
-				blendOptionVector
+				blendOptionVector,
+				std::vector(pushConstants, pushConstants + pushConstantCount)
 			)
 		);
 	}
@@ -428,6 +443,39 @@ extern "C" {
 		);
 	}
 
+	DLLEXPORT native_handle dbp_render_context_create_index_buffer(
+		RenderContext* instance,
+		const uint8_t* data,
+		const uint32_t indexCount,
+		const IndexType indexType,
+		const bool writable
+	)
+	{
+		return make_native_handle(
+			instance->createIndexBuffer(
+				std::vector(data, data + static_cast<uint32_t>(indexCount * getIndexSize(indexType))),
+				indexType,
+				writable
+			)
+		);
+	}
+
+	DLLEXPORT native_handle dbp_render_context_create_indirect_draw_buffer(
+		RenderContext* instance,
+		const uint8_t* data,
+		const uint32_t commandCount,
+		const bool indexed
+	)
+	{
+		const auto commandSize = indexed ? sizeof(DrawIndexedIndirectCommand) : sizeof(DrawIndirectCommand);
+		return make_native_handle(
+			instance->createIndirectDrawBuffer(
+				std::vector(data, data + static_cast<uint32_t>(commandCount * commandSize)),
+				indexed
+			)
+		);
+	}
+
 	DLLEXPORT native_handle dbp_render_context_create_texture_binding(
 		RenderContext* instance,
 		const native_handle shader,
@@ -453,14 +501,19 @@ extern "C" {
 		const TextureWrapping wrapping,
 		const TextureBorderColor borderColor,
 		const bool enableAnisotropy,
-		const uint32_t anisotropyLevel
+		const uint32_t anisotropyLevel,
+		const TextureMipmapMode mipmapMode,
+		const float minLod,
+		const float maxLod,
+		const float lodBias
 	)
 	{
 		return make_native_handle(
 			instance->createTextureSampler(
 				minFiltering, magFiltering,
 				wrapping, borderColor,
-				enableAnisotropy, anisotropyLevel
+				enableAnisotropy, anisotropyLevel,
+				mipmapMode, minLod, maxLod, lodBias
 			)
 		);
 	}
@@ -469,17 +522,85 @@ extern "C" {
 		RenderContext* instance,
 		const uint32_t width,
 		const uint32_t height,
+		const TextureFormat format,
 		const uint8_t* data,
-		const uint32_t dataLength
+		const uint32_t dataLength,
+		const TextureMipmaps mipmaps,
+		const uint32_t mipLevels
 	)
 	{
 		return make_native_handle(
 			instance->createTexture(
 				width, height,
+				format,
+				std::vector(data, data + dataLength),
+				mipmaps, mipLevels
+			)
+		);
+	}
+
+	DLLEXPORT native_handle dbp_render_context_create_texture_array(
+		RenderContext* instance,
+		const uint32_t width,
+		const uint32_t height,
+		const uint32_t layers,
+		const TextureFormat format,
+		const uint8_t* data,
+		const uint32_t dataLength,
+		const TextureMipmaps mipmaps,
+		const uint32_t mipLevels
+	)
+	{
+		return make_native_handle(
+			instance->createTextureArray(
+				width, height, layers,
+				format,
+				std::vector(data, data + dataLength),
+				mipmaps, mipLevels
+			)
+		);
+	}
+
+	DLLEXPORT native_handle dbp_render_context_create_dynamic_texture(
+		RenderContext* instance,
+		const uint32_t width,
+		const uint32_t height,
+		const TextureFormat format,
+		const uint8_t* data,
+		const uint32_t dataLength
+	)
+	{
+		return make_native_handle(
+			instance->createDynamicTexture(
+				width, height,
+				format,
 				std::vector(data, data + dataLength)
 			)
 		);
 	}
+
+	DLLEXPORT native_handle dbp_render_context_create_texture_async(
+		RenderContext* instance,
+		const uint32_t width,
+		const uint32_t height,
+		const TextureFormat format,
+		const uint8_t* data,
+		const uint32_t dataLength,
+		const TextureMipmaps mipmaps,
+		const uint32_t mipLevels,
+		void(*callback)()
+	)
+	{
+		return make_native_handle(
+			instance->createTextureAsync(
+				width, height,
+				format,
+				std::vector(data, data + dataLength),
+				mipmaps, mipLevels,
+				callback
+			)
+		);
+	}
 	
 	DLLEXPORT native_handle dbp_render_context_create_command_buffer(RenderContext* instance)
 	{
@@ -499,4 +620,51 @@ extern "C" {
 			handle_share<CommandBuffer>(commandBuffer)
 		);
 	}
+
+	DLLEXPORT bool dbp_render_context_is_texture_format_supported(
+		RenderContext* instance,
+		const TextureFormat format
+	)
+	{
+		return instance->isTextureFormatSupported(format);
+	}
+
+	DLLEXPORT bool dbp_render_context_is_attachment_format_supported(
+		RenderContext* instance,
+		const TextureFormat format
+	)
+	{
+		return instance->isAttachmentFormatSupported(format);
+	}
+
+	DLLEXPORT void dbp_render_context_get_staging_stats(
+		RenderContext* instance,
+		StagingStats* stats
+	)
+	{
+		*stats = instance->getStagingStats();
+	}
+
+	DLLEXPORT void* dbp_render_context_allocate_transient_vertices(
+		RenderContext* instance,
+		const uint32_t vertexCount,
+		const uint32_t vertexSize,
+		TransientVertexRange* range
+	)
+	{
+		const auto size = static_cast<uint64_t>(vertexCount) * vertexSize;
+		if (size > std::numeric_limits<uint32_t>::max())
+			throw std::runtime_error("Transient vertex data exceeds the maximum allocation size.");
+		const auto vertices = instance->allocateTransientVertices(static_cast<uint32_t>(size), vertexSize);
+		*range = vertices.range;
+		return vertices.data;
+	}
+
+	DLLEXPORT void dbp_render_context_get_transient_vertex_stats(
+		RenderContext* instance,
+		StagingStats* stats
+	)
+	{
+		*stats = instance->getTransientVertexStats();
+	}
 }
@@ -1,11 +1,15 @@
 ﻿#pragma once
+#include <functional>
 #include <memory>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 #include "command_buffer.h"
 #include "framebuffer.h"
 #include "framebuffer_format.h"
+#include "index_buffer.h"
+#include "indirect_draw_buffer.h"
 #include "render_pipeline.h"
 #include "render_target.h"
 #include "shader.h"
@@ -42,7 +46,12 @@ namespace digbuild::platform::render
 		LONG, ULONG,
 		FLOAT, DOUBLE,
 		FLOAT2, FLOAT3, FLOAT4,
-		FLOAT4X4
+		FLOAT4X4,
+		// Packed types, read by shaders as floats
+		HALF2, HALF4,
+		SNORM8X4, UNORM8X4,
+		UNORM16X2,
+		A2B10G10R10
 	};
 	
 	enum class VertexFormatDescriptorRate : uint8_t
@@ -182,6 +191,22 @@ namespace digbuild::platform::render
 	{
 		VERTEX, FRAGMENT
 	};
+	enum class ShaderStages : uint8_t
+	{
+		VERTEX = 1 << 0,
+		FRAGMENT = 1 << 1
+	};
+	inline ShaderStages operator&(ShaderStages lhs, ShaderStages rhs)
+	{
+		using Underlying = std::underlying_type_t<ShaderStages>;
+		return static_cast<ShaderStages>(static_cast<Underlying>(lhs) & static_cast<Underlying>(rhs));
+	}
+	struct PushConstantRange
+	{
+		const ShaderStages stages;
+		const uint32_t offset;
+		const uint32_t size;
+	};
 	struct ShaderUniformProperty
 	{
 		const NumericType type;
@@ -203,6 +228,11 @@ namespace digbuild::platform::render
 		LINEAR,
 		NEAREST
 	};
+	enum class TextureMipmapMode : uint8_t
+	{
+		LINEAR,
+		NEAREST
+	};
 	enum class TextureWrapping : uint8_t
 	{
 		REPEAT, MIRRORED_REPEAT,
@@ -216,6 +246,23 @@ namespace digbuild::platform::render
 		OPAQUE_WHITE
 	};
 	
+	struct StagingStats
+	{
+		uint64_t capacity;
+		uint64_t used;
+		uint64_t peakUsed;
+		uint32_t chunkCount;
+		uint32_t dedicatedChunkCount;
+		uint32_t directChunkCount;
+	};
+
+	// Vertex memory that is only valid for the frame being built
+	struct TransientVertices
+	{
+		void* data;
+		TransientVertexRange range;
+	};
+	
 	class RenderContext
 	{
 	public:
@@ -251,7 +298,8 @@ namespace digbuild::platform::render
 			const VertexFormatDescriptor& vertexFormat,
 			const VertexFormatDescriptor& instanceFormat,
 			RenderState state,
-			const std::vector<BlendOptions>& blendOptions
+			const std::vector<BlendOptions>& blendOptions,
+			const std::vector<PushConstantRange>& pushConstants
 		) = 0;
 
 		[[nodiscard]] virtual std::shared_ptr<UniformBinding> createUniformBinding(
@@ -270,6 +318,17 @@ namespace digbuild::platform::render
 			bool writable
 		) = 0;
 
+		[[nodiscard]] virtual std::shared_ptr<IndexBuffer> createIndexBuffer(
+			const std::vector<uint8_t>& initialData,
+			IndexType indexType,
+			bool writable
+		) = 0;
+
+		[[nodiscard]] virtual std::shared_ptr<IndirectDrawBuffer> createIndirectDrawBuffer(
+			const std::vector<uint8_t>& initialData,
+			bool indexed
+		) = 0;
+
 		[[nodiscard]] virtual std::shared_ptr<TextureBinding> createTextureBinding(
 			const std::shared_ptr<Shader>& shader,
 			uint32_t binding,
@@ -283,15 +342,49 @@ namespace digbuild::platform::render
 			TextureWrapping wrapping,
 			TextureBorderColor borderColor,
 			bool enableAnisotropy,
-			uint32_t anisotropyLevel
+			uint32_t anisotropyLevel,
+			TextureMipmapMode mipmapMode,
+			float minLod,
+			float maxLod,
+			float lodBias
 		) = 0;
 
 		[[nodiscard]] virtual std::shared_ptr<Texture> createTexture(
 			uint32_t width,
 			uint32_t height,
+			TextureFormat format,
+			const std::vector<uint8_t>& data,
+			TextureMipmaps mipmaps,
+			uint32_t mipLevels
+		) = 0;
+
+		[[nodiscard]] virtual std::shared_ptr<Texture> createTextureArray(
+			uint32_t width,
+			uint32_t height,
+			uint32_t layers,
+			TextureFormat format,
+			const std::vector<uint8_t>& data,
+			TextureMipmaps mipmaps,
+			uint32_t mipLevels
+		) = 0;
+
+		[[nodiscard]] virtual std::shared_ptr<Texture> createDynamicTexture(
+			uint32_t width,
+			uint32_t height,
+			TextureFormat format,
 			const std::vector<uint8_t>& data
 		) = 0;
 
+		[[nodiscard]] virtual std::shared_ptr<Texture> createTextureAsync(
+			uint32_t width,
+			uint32_t height,
+			TextureFormat format,
+			const std::vector<uint8_t>& data,
+			TextureMipmaps mipmaps,
+			uint32_t mipLevels,
+			std::function<void()> onReady
+		) = 0;
+
 		[[nodiscard]] virtual std::shared_ptr<CommandBuffer> createCommandBuffer(
 		) = 0;
 
@@ -299,5 +392,13 @@ namespace digbuild::platform::render
 			const std::shared_ptr<IRenderTarget>& renderTarget,
 			const std::shared_ptr<CommandBuffer>& commandBuffer
 		) = 0;
+
+		[[nodiscard]] virtual bool isTextureFormatSupported(TextureFormat format) = 0;
+		[[nodiscard]] virtual bool isAttachmentFormatSupported(TextureFormat format) = 0;
+
+		[[nodiscard]] virtual StagingStats getStagingStats() = 0;
+
+		[[nodiscard]] virtual TransientVertices allocateTransientVertices(uint32_t size, uint32_t vertexSize) = 0;
+		[[nodiscard]] virtual StagingStats getTransientVertexStats() = 0;
 	};
 }
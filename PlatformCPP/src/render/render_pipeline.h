@@ -5,6 +5,9 @@
 
 namespace digbuild::platform::render
 {
+	// The most push constant data a pipeline can declare, and a single command can carry
+	constexpr uint32_t MAX_PUSH_CONSTANTS_SIZE = 128;
+	
 	class RenderPipeline : public Resource, public std::enable_shared_from_this<RenderPipeline>
 	{
 	public:
@@ -19,4 +19,46 @@ extern "C"
 	{
 		return handle_cast<Texture>(instance)->getHeight();
 	}
+	DLLEXPORT uint32_t dbp_texture_get_layers(
+		const native_handle instance
+	)
+	{
+		return handle_cast<Texture>(instance)->getLayers();
+	}
+	DLLEXPORT uint32_t dbp_texture_get_mip_levels(
+		const native_handle instance
+	)
+	{
+		return handle_cast<Texture>(instance)->getMipLevels();
+	}
+	DLLEXPORT bool dbp_texture_is_ready(
+		const native_handle instance
+	)
+	{
+		return handle_cast<Texture>(instance)->isReady();
+	}
+	DLLEXPORT void dbp_texture_write(
+		const native_handle instance,
+		const uint8_t* data,
+		const uint32_t dataLength
+	)
+	{
+		handle_cast<Texture>(instance)->write(std::vector(data, data + dataLength));
+	}
+	DLLEXPORT void dbp_texture_write_region(
+		const native_handle instance,
+		const uint32_t x, const uint32_t y,
+		const uint32_t width, const uint32_t height,
+		const uint32_t layer, const uint32_t mipLevel,
+		const uint8_t* data,
+		const uint32_t dataLength
+	)
+	{
+		handle_cast<Texture>(instance)->writeRegion(
+			x, y,
+			width, height,
+			layer, mipLevel,
+			std::vector(data, data + dataLength)
+		);
+	}
 }
@@ -1,5 +1,8 @@
 ﻿#pragma once
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include "resource.h"
 
@@ -10,13 +13,129 @@ namespace digbuild::platform::render
 		R8G8B8A8_SRGB,
 		B8G8R8A8_SRGB,
 		R32G32B32A32S,
+		BC1_RGBA_UNORM,
+		BC1_RGBA_SRGB,
+		BC3_UNORM,
+		BC3_SRGB,
+		BC4_UNORM,
+		BC5_UNORM,
+		BC7_UNORM,
+		BC7_SRGB,
+		R8_UNORM,
+		R8G8_UNORM,
+		R16_SFLOAT,
+		R16G16B16A16_SFLOAT,
+		B10G11R11_UFLOAT,
+		// Depth formats can only be used as framebuffer attachments
+		D16_UNORM = 0xFD,
+		D24_UNORM_S8_UINT = 0xFE,
 		D32SFLOAT_S8UINT = 0xFF
 	};
 
+	inline bool isDepthFormat(const TextureFormat format)
+	{
+		return format == TextureFormat::D16_UNORM ||
+			format == TextureFormat::D24_UNORM_S8_UINT ||
+			format == TextureFormat::D32SFLOAT_S8UINT;
+	}
+
+	inline bool hasStencil(const TextureFormat format)
+	{
+		return format == TextureFormat::D24_UNORM_S8_UINT ||
+			format == TextureFormat::D32SFLOAT_S8UINT;
+	}
+
+	// The width and height of a texel block, which regions of the image have to be aligned to
+	inline uint32_t getBlockExtent(const TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1_RGBA_UNORM:
+		case TextureFormat::BC1_RGBA_SRGB:
+		case TextureFormat::BC3_UNORM:
+		case TextureFormat::BC3_SRGB:
+		case TextureFormat::BC4_UNORM:
+		case TextureFormat::BC5_UNORM:
+		case TextureFormat::BC7_UNORM:
+		case TextureFormat::BC7_SRGB:
+			return 4;
+		default:
+			return 1;
+		}
+	}
+
+	// The size of a tightly packed image, in bytes. Block compressed formats store 4x4 texel blocks,
+	// so partial blocks at the edges take up as much space as full ones.
+	inline uint32_t getImageSize(const TextureFormat format, const uint32_t width, const uint32_t height)
+	{
+		const auto blocks = ((width + 3) / 4) * ((height + 3) / 4);
+		switch (format)
+		{
+		case TextureFormat::R8_UNORM:
+			return width * height;
+		case TextureFormat::R8G8_UNORM:
+		case TextureFormat::R16_SFLOAT:
+			return width * height * 2;
+		case TextureFormat::R8G8B8A8_SRGB:
+		case TextureFormat::B8G8R8A8_SRGB:
+		case TextureFormat::B10G11R11_UFLOAT:
+			return width * height * 4;
+		case TextureFormat::R16G16B16A16_SFLOAT:
+			return width * height * 8;
+		case TextureFormat::R32G32B32A32S:
+			return width * height * 16;
+		case TextureFormat::BC1_RGBA_UNORM:
+		case TextureFormat::BC1_RGBA_SRGB:
+		case TextureFormat::BC4_UNORM:
+			return blocks * 8;
+		case TextureFormat::BC3_UNORM:
+		case TextureFormat::BC3_SRGB:
+		case TextureFormat::BC5_UNORM:
+		case TextureFormat::BC7_UNORM:
+		case TextureFormat::BC7_SRGB:
+			return blocks * 16;
+		default:
+			throw std::runtime_error("Texture format cannot be uploaded.");
+		}
+	}
+
+	enum class TextureMipmaps : uint8_t
+	{
+		// Only the base level is allocated
+		NONE,
+		// The levels below the base are generated from it on the GPU
+		GENERATE,
+		// The data holds every level, largest first and tightly packed
+		PRECOMPUTED
+	};
+
+	// Requests every mip level down to 1x1
+	constexpr uint32_t FULL_MIP_CHAIN = 0;
+
+	inline uint32_t getFullMipLevels(const uint32_t width, const uint32_t height)
+	{
+		uint32_t levels = 1;
+		while (std::max(width, height) >> levels)
+			++levels;
+		return levels;
+	}
+
 	class Texture : public Resource, public std::enable_shared_from_this<Texture>
 	{
 	public:
 		[[nodiscard]] virtual uint32_t getWidth() = 0;
 		[[nodiscard]] virtual uint32_t getHeight() = 0;
+		[[nodiscard]] virtual uint32_t getLayers() = 0;
+		[[nodiscard]] virtual uint32_t getMipLevels() = 0;
+		[[nodiscard]] virtual bool isReady() = 0;
+
+		virtual void write(const std::vector<uint8_t>& data) = 0;
+
+		virtual void writeRegion(
+			uint32_t x, uint32_t y,
+			uint32_t width, uint32_t height,
+			uint32_t layer, uint32_t mipLevel,
+			const std::vector<uint8_t>& data
+		) = 0;
 	};
 }
@@ -17,4 +17,36 @@ extern "C"
 	{
 		handle_cast<UniformBuffer>(instance)->write(std::vector(data, data + dataLength));
 	}
+
+	DLLEXPORT void* dbp_uniform_buffer_map(
+		const native_handle instance,
+		const uint32_t dataLength
+	)
+	{
+		return handle_cast<UniformBuffer>(instance)->map(dataLength);
+	}
+
+	DLLEXPORT void dbp_uniform_buffer_commit(
+		const native_handle instance,
+		const uint32_t dataLength
+	)
+	{
+		handle_cast<UniformBuffer>(instance)->commit(dataLength);
+	}
+
+	DLLEXPORT void dbp_uniform_buffer_set_capacity_policy(
+		const native_handle instance,
+		const BufferCapacityPolicy* policy
+	)
+	{
+		handle_cast<UniformBuffer>(instance)->setCapacityPolicy(*policy);
+	}
+
+	DLLEXPORT void dbp_uniform_buffer_get_stats(
+		const native_handle instance,
+		BufferStats* stats
+	)
+	{
+		*stats = handle_cast<UniformBuffer>(instance)->getStats();
+	}
 }
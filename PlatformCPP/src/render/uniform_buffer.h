@@ -2,6 +2,7 @@
 #include <memory>
 #include <vector>
 
+#include "buffer_capacity.h"
 #include "resource.h"
 
 namespace digbuild::platform::render
@@ -17,5 +18,12 @@ namespace digbuild::platform::render
 		UniformBuffer& operator=(UniformBuffer&& other) noexcept = delete;
 		
 		virtual void write(const std::vector<uint8_t>& data) = 0;
+
+		// Returns writable memory for the given number of bytes, which replaces the contents once committed.
+		[[nodiscard]] virtual void* map(uint32_t size) = 0;
+		virtual void commit(uint32_t size) = 0;
+
+		virtual void setCapacityPolicy(const BufferCapacityPolicy& policy) = 0;
+		[[nodiscard]] virtual BufferStats getStats() = 0;
 	};
 }
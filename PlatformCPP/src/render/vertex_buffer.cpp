@@ -18,4 +18,49 @@ extern "C"
 		auto buf = handle_cast<VertexBuffer>(instance);
 		buf->write(std::vector(data, data + (vertexCount * buf->getVertexSize())));
 	}
+
+	DLLEXPORT void dbp_vertex_buffer_write_range(
+		const native_handle instance,
+		const uint32_t offset,
+		const uint8_t* data,
+		const uint32_t vertexCount
+	)
+	{
+		auto buf = handle_cast<VertexBuffer>(instance);
+		buf->writeRange(offset, std::vector(data, data + (vertexCount * buf->getVertexSize())));
+	}
+
+	DLLEXPORT void* dbp_vertex_buffer_map(
+		const native_handle instance,
+		const uint32_t vertexCount
+	)
+	{
+		auto buf = handle_cast<VertexBuffer>(instance);
+		return buf->map(vertexCount * buf->getVertexSize());
+	}
+
+	DLLEXPORT void dbp_vertex_buffer_commit(
+		const native_handle instance,
+		const uint32_t vertexCount
+	)
+	{
+		auto buf = handle_cast<VertexBuffer>(instance);
+		buf->commit(vertexCount * buf->getVertexSize());
+	}
+
+	DLLEXPORT void dbp_vertex_buffer_set_capacity_policy(
+		const native_handle instance,
+		const BufferCapacityPolicy* policy
+	)
+	{
+		handle_cast<VertexBuffer>(instance)->setCapacityPolicy(*policy);
+	}
+
+	DLLEXPORT void dbp_vertex_buffer_get_stats(
+		const native_handle instance,
+		BufferStats* stats
+	)
+	{
+		*stats = handle_cast<VertexBuffer>(instance)->getStats();
+	}
 }
@@ -2,6 +2,7 @@
 #include <memory>
 #include <vector>
 
+#include "buffer_capacity.h"
 #include "resource.h"
 
 namespace digbuild::platform::render
@@ -19,5 +20,14 @@ namespace digbuild::platform::render
 		[[nodiscard]] virtual uint32_t getVertexSize() = 0;
 		
 		virtual void write(const std::vector<uint8_t>& data) = 0;
+		// Overwrites part of the contents, starting at the given vertex.
+		virtual void writeRange(uint32_t offset, const std::vector<uint8_t>& data) = 0;
+
+		// Returns writable memory for the given number of bytes, which replaces the contents once committed.
+		[[nodiscard]] virtual void* map(uint32_t size) = 0;
+		virtual void commit(uint32_t size) = 0;
+
+		virtual void setCapacityPolicy(const BufferCapacityPolicy& policy) = 0;
+		[[nodiscard]] virtual BufferStats getStats() = 0;
 	};
 }
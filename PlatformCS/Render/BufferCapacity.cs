@@ -0,0 +1,57 @@
+﻿namespace DigBuild.Platform.Render
+{
+    /// <summary>
+    /// Controls how a writable buffer's capacity follows the size of its contents.
+    /// </summary>
+    public readonly struct BufferCapacityPolicy
+    {
+        /// <summary>
+        /// The default policy.
+        /// </summary>
+        public static readonly BufferCapacityPolicy Default = new(1.5f, 0.25f, 120);
+
+        /// <summary>
+        /// The factor by which the capacity grows when the contents no longer fit.
+        /// </summary>
+        public readonly float GrowthFactor;
+        /// <summary>
+        /// The fraction of the capacity below which usage must stay for the buffer to shrink.
+        /// </summary>
+        public readonly float ShrinkThreshold;
+        /// <summary>
+        /// The number of consecutive frames usage must stay below the threshold, or 0 to never shrink.
+        /// </summary>
+        public readonly uint ShrinkDelay;
+
+        public BufferCapacityPolicy(float growthFactor, float shrinkThreshold, uint shrinkDelay)
+        {
+            GrowthFactor = growthFactor;
+            ShrinkThreshold = shrinkThreshold;
+            ShrinkDelay = shrinkDelay;
+        }
+    }
+
+    /// <summary>
+    /// Memory usage statistics of a buffer, across all of its frames in flight.
+    /// </summary>
+    public readonly struct BufferStats
+    {
+        /// <summary>
+        /// The allocated capacity, in bytes.
+        /// </summary>
+        public readonly ulong Capacity;
+        /// <summary>
+        /// The size of the contents, in bytes.
+        /// </summary>
+        public readonly ulong Used;
+        /// <summary>
+        /// The number of times the buffer has been reallocated.
+        /// </summary>
+        public readonly uint Reallocations;
+        /// <summary>
+        /// The part of the capacity in device memory that is written to directly, skipping staging, in bytes.
+        /// Zero when the device has no host-visible device-local memory or it was over budget.
+        /// </summary>
+        public readonly ulong DirectCapacity;
+    }
+}
\ No newline at end of file
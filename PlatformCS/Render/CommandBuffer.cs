@@ -9,7 +9,11 @@ namespace DigBuild.Platform.Render
     [NativeSymbols("dbp_command_buffer_", SymbolTransformationMethod.Underscore)]
     internal interface ICommandBufferBindings
     {
-        void Commit(IntPtr instance, IntPtr context, IntPtr format, IntPtr commands, uint commandCount);
+        void Commit(
+            IntPtr instance, IntPtr context, IntPtr format,
+            IntPtr commands, uint commandCount,
+            IntPtr pushConstantData, uint pushConstantDataSize
+        );
     }
 
     /// <summary>
@@ -50,10 +54,20 @@ namespace DigBuild.Platform.Render
     /// </summary>
     public sealed class CommandBufferRecorder : IDisposable
     {
+        /// <summary>
+        /// A draw count that covers everything from the first element to the end of the buffer.
+        /// </summary>
+        public const uint Remaining = uint.MaxValue;
+        /// <summary>
+        /// The most push constant data a pipeline can declare, and a single command can carry, in bytes.
+        /// </summary>
+        public const int MaxPushConstantsSize = CommandBufferCmd.PushConstants.MaxSize;
+
         private readonly CommandBuffer _parent;
         private readonly FramebufferFormat _format;
         private readonly IntPtr _contextPtr;
         private readonly PooledNativeBuffer<CommandBufferCmd> _commands;
+        private readonly PooledNativeBuffer<byte> _pushConstantData;
         private readonly Dictionary<IBindingHandle, (IUniformBinding, uint)> _uniformBindings = new();
         private readonly Dictionary<ShaderSamplerHandle, TextureBinding> _textureBindings = new();
         private bool _committed;
@@ -69,6 +83,7 @@ namespace DigBuild.Platform.Render
             _format = format;
             _contextPtr = context.Ptr;
             _commands = bufferPool.Request<CommandBufferCmd>();
+            _pushConstantData = bufferPool.Request<byte>();
         }
 
         /// <summary>
@@ -160,20 +175,50 @@ namespace DigBuild.Platform.Render
             ));
         }
 
+        /// <summary>
+        /// Updates push constant data for the following draws.
+        /// </summary>
+        /// <typeparam name="T">The push constant type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="value">The data</param>
+        /// <param name="offset">The offset to write the data at, in bytes</param>
+        public unsafe void PushConstants<T>(
+            IRenderPipeline pipeline,
+            T value,
+            uint offset = 0
+        ) where T : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            if (offset + sizeof(T) > MaxPushConstantsSize)
+                throw new ArgumentException($"Push constants cannot exceed {MaxPushConstantsSize} bytes.");
+            // The data is kept out of line so that it does not grow every other command
+            var dataOffset = _pushConstantData.Count;
+            new ReadOnlySpan<byte>(&value, sizeof(T)).CopyTo(_pushConstantData.Add((uint) sizeof(T)));
+            _commands.Add(new CommandBufferCmd.PushConstants(pipeline.Handle, offset, (uint) sizeof(T), dataOffset));
+        }
+
         /// <summary>
         /// Draws the geometry in the vertex buffer using the pipline.
         /// </summary>
         /// <typeparam name="TVertex">The vertex type</typeparam>
         /// <param name="pipeline">The pipeline</param>
         /// <param name="vertexBuffer">The vertex buffer</param>
+        /// <param name="firstVertex">The index of the first vertex to draw</param>
+        /// <param name="vertexCount">The number of vertices to draw</param>
         public void Draw<TVertex>(
             RenderPipeline<TVertex> pipeline,
-            VertexBuffer<TVertex> vertexBuffer
+            VertexBuffer<TVertex> vertexBuffer,
+            uint firstVertex = 0,
+            uint vertexCount = Remaining
         ) where TVertex : unmanaged
         {
             if (_committed)
                 throw new RecordingAlreadyCommittedException();
-            _commands.Add(new CommandBufferCmd.Draw(pipeline.Handle, vertexBuffer.Handle, IntPtr.Zero));
+            _commands.Add(new CommandBufferCmd.Draw(
+                pipeline.Handle, vertexBuffer.Handle, IntPtr.Zero,
+                firstVertex, vertexCount, 0, 1
+            ));
         }
 
         /// <summary>
@@ -184,16 +229,303 @@ namespace DigBuild.Platform.Render
         /// <param name="pipeline">The pipeline</param>
         /// <param name="vertexBuffer">The vertex buffer</param>
         /// <param name="instanceBuffer">The instance buffer</param>
+        /// <param name="firstVertex">The index of the first vertex to draw</param>
+        /// <param name="vertexCount">The number of vertices to draw</param>
+        /// <param name="firstInstance">The index of the first instance to draw</param>
+        /// <param name="instanceCount">The number of instances to draw</param>
         public void Draw<TVertex, TInstance>(
             RenderPipeline<TVertex, TInstance> pipeline,
             VertexBuffer<TVertex> vertexBuffer,
-            VertexBuffer<TInstance> instanceBuffer
+            VertexBuffer<TInstance> instanceBuffer,
+            uint firstVertex = 0,
+            uint vertexCount = Remaining,
+            uint firstInstance = 0,
+            uint instanceCount = Remaining
+        ) where TVertex : unmanaged
+            where TInstance : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.Draw(
+                pipeline.Handle, vertexBuffer.Handle, instanceBuffer.Handle,
+                firstVertex, vertexCount, firstInstance, instanceCount
+            ));
+        }
+
+        /// <summary>
+        /// Draws the geometry in the vertex buffer, in the order given by the index buffer, using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <typeparam name="TIndex">The index type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertexBuffer">The vertex buffer</param>
+        /// <param name="indexBuffer">The index buffer</param>
+        /// <param name="firstIndex">The position of the first index to draw</param>
+        /// <param name="indexCount">The number of indices to draw</param>
+        /// <param name="vertexOffset">The value added to each index before reading the vertex</param>
+        public void DrawIndexed<TVertex, TIndex>(
+            RenderPipeline<TVertex> pipeline,
+            VertexBuffer<TVertex> vertexBuffer,
+            IndexBuffer<TIndex> indexBuffer,
+            uint firstIndex = 0,
+            uint indexCount = Remaining,
+            int vertexOffset = 0
+        ) where TVertex : unmanaged
+            where TIndex : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawIndexed(
+                pipeline.Handle, vertexBuffer.Handle, indexBuffer.Handle, IntPtr.Zero,
+                firstIndex, indexCount, vertexOffset, 0, 1
+            ));
+        }
+
+        /// <summary>
+        /// Draws the instanced geometry in the vertex buffers, in the order given by the index buffer, using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <typeparam name="TIndex">The index type</typeparam>
+        /// <typeparam name="TInstance">The instance type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertexBuffer">The vertex buffer</param>
+        /// <param name="indexBuffer">The index buffer</param>
+        /// <param name="instanceBuffer">The instance buffer</param>
+        /// <param name="firstIndex">The position of the first index to draw</param>
+        /// <param name="indexCount">The number of indices to draw</param>
+        /// <param name="vertexOffset">The value added to each index before reading the vertex</param>
+        /// <param name="firstInstance">The index of the first instance to draw</param>
+        /// <param name="instanceCount">The number of instances to draw</param>
+        public void DrawIndexed<TVertex, TIndex, TInstance>(
+            RenderPipeline<TVertex, TInstance> pipeline,
+            VertexBuffer<TVertex> vertexBuffer,
+            IndexBuffer<TIndex> indexBuffer,
+            VertexBuffer<TInstance> instanceBuffer,
+            uint firstIndex = 0,
+            uint indexCount = Remaining,
+            int vertexOffset = 0,
+            uint firstInstance = 0,
+            uint instanceCount = Remaining
+        ) where TVertex : unmanaged
+            where TIndex : unmanaged
+            where TInstance : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawIndexed(
+                pipeline.Handle, vertexBuffer.Handle, indexBuffer.Handle, instanceBuffer.Handle,
+                firstIndex, indexCount, vertexOffset, firstInstance, instanceCount
+            ));
+        }
+
+        /// <summary>
+        /// Draws the transient vertices using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertices">The transient vertices</param>
+        /// <param name="firstVertex">The index of the first vertex to draw</param>
+        /// <param name="vertexCount">The number of vertices to draw</param>
+        public void Draw<TVertex>(
+            RenderPipeline<TVertex> pipeline,
+            TransientVertices<TVertex> vertices,
+            uint firstVertex = 0,
+            uint vertexCount = Remaining
+        ) where TVertex : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawTransient(
+                pipeline.Handle, vertices.Range, IntPtr.Zero,
+                firstVertex, vertexCount, 0, 1
+            ));
+        }
+
+        /// <summary>
+        /// Draws the instanced transient vertices using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <typeparam name="TInstance">The instance type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertices">The transient vertices</param>
+        /// <param name="instanceBuffer">The instance buffer</param>
+        /// <param name="firstVertex">The index of the first vertex to draw</param>
+        /// <param name="vertexCount">The number of vertices to draw</param>
+        /// <param name="firstInstance">The index of the first instance to draw</param>
+        /// <param name="instanceCount">The number of instances to draw</param>
+        public void Draw<TVertex, TInstance>(
+            RenderPipeline<TVertex, TInstance> pipeline,
+            TransientVertices<TVertex> vertices,
+            VertexBuffer<TInstance> instanceBuffer,
+            uint firstVertex = 0,
+            uint vertexCount = Remaining,
+            uint firstInstance = 0,
+            uint instanceCount = Remaining
         ) where TVertex : unmanaged
             where TInstance : unmanaged
         {
             if (_committed)
                 throw new RecordingAlreadyCommittedException();
-            _commands.Add(new CommandBufferCmd.Draw(pipeline.Handle, vertexBuffer.Handle, instanceBuffer.Handle));
+            _commands.Add(new CommandBufferCmd.DrawTransient(
+                pipeline.Handle, vertices.Range, instanceBuffer.Handle,
+                firstVertex, vertexCount, firstInstance, instanceCount
+            ));
+        }
+
+        /// <summary>
+        /// Draws the transient vertices, in the order given by the index buffer, using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <typeparam name="TIndex">The index type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertices">The transient vertices</param>
+        /// <param name="indexBuffer">The index buffer</param>
+        /// <param name="firstIndex">The position of the first index to draw</param>
+        /// <param name="indexCount">The number of indices to draw</param>
+        /// <param name="vertexOffset">The value added to each index before reading the vertex</param>
+        public void DrawIndexed<TVertex, TIndex>(
+            RenderPipeline<TVertex> pipeline,
+            TransientVertices<TVertex> vertices,
+            IndexBuffer<TIndex> indexBuffer,
+            uint firstIndex = 0,
+            uint indexCount = Remaining,
+            int vertexOffset = 0
+        ) where TVertex : unmanaged
+            where TIndex : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawIndexedTransient(
+                pipeline.Handle, vertices.Range, indexBuffer.Handle, IntPtr.Zero,
+                firstIndex, indexCount, vertexOffset, 0, 1
+            ));
+        }
+
+        /// <summary>
+        /// Draws the instanced transient vertices, in the order given by the index buffer, using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <typeparam name="TIndex">The index type</typeparam>
+        /// <typeparam name="TInstance">The instance type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertices">The transient vertices</param>
+        /// <param name="indexBuffer">The index buffer</param>
+        /// <param name="instanceBuffer">The instance buffer</param>
+        /// <param name="firstIndex">The position of the first index to draw</param>
+        /// <param name="indexCount">The number of indices to draw</param>
+        /// <param name="vertexOffset">The value added to each index before reading the vertex</param>
+        /// <param name="firstInstance">The index of the first instance to draw</param>
+        /// <param name="instanceCount">The number of instances to draw</param>
+        public void DrawIndexed<TVertex, TIndex, TInstance>(
+            RenderPipeline<TVertex, TInstance> pipeline,
+            TransientVertices<TVertex> vertices,
+            IndexBuffer<TIndex> indexBuffer,
+            VertexBuffer<TInstance> instanceBuffer,
+            uint firstIndex = 0,
+            uint indexCount = Remaining,
+            int vertexOffset = 0,
+            uint firstInstance = 0,
+            uint instanceCount = Remaining
+        ) where TVertex : unmanaged
+            where TIndex : unmanaged
+            where TInstance : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawIndexedTransient(
+                pipeline.Handle, vertices.Range, indexBuffer.Handle, instanceBuffer.Handle,
+                firstIndex, indexCount, vertexOffset, firstInstance, instanceCount
+            ));
+        }
+
+        /// <summary>
+        /// Draws the geometry in the vertex buffer once per command in the indirect buffer, using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertexBuffer">The vertex buffer</param>
+        /// <param name="indirectBuffer">The draw commands</param>
+        public void DrawIndirect<TVertex>(
+            RenderPipeline<TVertex> pipeline,
+            VertexBuffer<TVertex> vertexBuffer,
+            IndirectDrawBuffer<DrawIndirectCommand> indirectBuffer
+        ) where TVertex : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawIndirect(pipeline.Handle, vertexBuffer.Handle, IntPtr.Zero, IntPtr.Zero, indirectBuffer.Handle));
+        }
+
+        /// <summary>
+        /// Draws the instanced geometry in the vertex buffers once per command in the indirect buffer, using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <typeparam name="TInstance">The instance type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertexBuffer">The vertex buffer</param>
+        /// <param name="instanceBuffer">The instance buffer</param>
+        /// <param name="indirectBuffer">The draw commands</param>
+        public void DrawIndirect<TVertex, TInstance>(
+            RenderPipeline<TVertex, TInstance> pipeline,
+            VertexBuffer<TVertex> vertexBuffer,
+            VertexBuffer<TInstance> instanceBuffer,
+            IndirectDrawBuffer<DrawIndirectCommand> indirectBuffer
+        ) where TVertex : unmanaged
+            where TInstance : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawIndirect(pipeline.Handle, vertexBuffer.Handle, IntPtr.Zero, instanceBuffer.Handle, indirectBuffer.Handle));
+        }
+
+        /// <summary>
+        /// Draws the geometry in the vertex buffer, in the order given by the index buffer, once per command
+        /// in the indirect buffer, using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <typeparam name="TIndex">The index type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertexBuffer">The vertex buffer</param>
+        /// <param name="indexBuffer">The index buffer</param>
+        /// <param name="indirectBuffer">The draw commands</param>
+        public void DrawIndirect<TVertex, TIndex>(
+            RenderPipeline<TVertex> pipeline,
+            VertexBuffer<TVertex> vertexBuffer,
+            IndexBuffer<TIndex> indexBuffer,
+            IndirectDrawBuffer<DrawIndexedIndirectCommand> indirectBuffer
+        ) where TVertex : unmanaged
+            where TIndex : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawIndirect(pipeline.Handle, vertexBuffer.Handle, indexBuffer.Handle, IntPtr.Zero, indirectBuffer.Handle));
+        }
+
+        /// <summary>
+        /// Draws the instanced geometry in the vertex buffers, in the order given by the index buffer, once per command
+        /// in the indirect buffer, using the pipeline.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex type</typeparam>
+        /// <typeparam name="TIndex">The index type</typeparam>
+        /// <typeparam name="TInstance">The instance type</typeparam>
+        /// <param name="pipeline">The pipeline</param>
+        /// <param name="vertexBuffer">The vertex buffer</param>
+        /// <param name="indexBuffer">The index buffer</param>
+        /// <param name="instanceBuffer">The instance buffer</param>
+        /// <param name="indirectBuffer">The draw commands</param>
+        public void DrawIndirect<TVertex, TIndex, TInstance>(
+            RenderPipeline<TVertex, TInstance> pipeline,
+            VertexBuffer<TVertex> vertexBuffer,
+            IndexBuffer<TIndex> indexBuffer,
+            VertexBuffer<TInstance> instanceBuffer,
+            IndirectDrawBuffer<DrawIndexedIndirectCommand> indirectBuffer
+        ) where TVertex : unmanaged
+            where TIndex : unmanaged
+            where TInstance : unmanaged
+        {
+            if (_committed)
+                throw new RecordingAlreadyCommittedException();
+            _commands.Add(new CommandBufferCmd.DrawIndirect(pipeline.Handle, vertexBuffer.Handle, indexBuffer.Handle, instanceBuffer.Handle, indirectBuffer.Handle));
         }
         
         /// <summary>
@@ -207,8 +539,14 @@ namespace DigBuild.Platform.Render
             _parent.Recording = false;
 
             var unpooled = _commands.Unpooled;
-            CommandBuffer.Bindings.Commit(_parent.Handle!, _contextPtr, _format.Handle, ((INativeBuffer<CommandBufferCmd>)unpooled).Ptr, unpooled.Count);
+            var pushConstantData = _pushConstantData.Unpooled;
+            CommandBuffer.Bindings.Commit(
+                _parent.Handle!, _contextPtr, _format.Handle,
+                ((INativeBuffer<CommandBufferCmd>)unpooled).Ptr, unpooled.Count,
+                ((INativeBuffer<byte>)pushConstantData).Ptr, pushConstantData.Count
+            );
             _commands.Dispose();
+            _pushConstantData.Dispose();
         }
 
         void IDisposable.Dispose() => Commit();
@@ -224,7 +562,12 @@ namespace DigBuild.Platform.Render
         [FieldOffset(sizeof(Type))] private readonly SetScissor _setScissor;
         [FieldOffset(sizeof(Type))] private readonly BindUniform _bindUniform;
         [FieldOffset(sizeof(Type))] private readonly BindTexture _bindTexture;
+        [FieldOffset(sizeof(Type))] private readonly PushConstants _pushConstants;
         [FieldOffset(sizeof(Type))] private readonly Draw _draw;
+        [FieldOffset(sizeof(Type))] private readonly DrawIndexed _drawIndexed;
+        [FieldOffset(sizeof(Type))] private readonly DrawIndirect _drawIndirect;
+        [FieldOffset(sizeof(Type))] private readonly DrawTransient _drawTransient;
+        [FieldOffset(sizeof(Type))] private readonly DrawIndexedTransient _drawIndexedTransient;
 
         private CommandBufferCmd(SetViewportScissor setViewportScissor) : this()
         {
@@ -256,18 +599,53 @@ namespace DigBuild.Platform.Render
             _bindTexture = bindTexture;
         }
 
+        private CommandBufferCmd(PushConstants pushConstants) : this()
+        {
+            _type = Type.PushConstants;
+            _pushConstants = pushConstants;
+        }
+
         private CommandBufferCmd(Draw draw) : this()
         {
             _type = Type.Draw;
             _draw = draw;
         }
 
+        private CommandBufferCmd(DrawIndexed drawIndexed) : this()
+        {
+            _type = Type.DrawIndexed;
+            _drawIndexed = drawIndexed;
+        }
+
+        private CommandBufferCmd(DrawIndirect drawIndirect) : this()
+        {
+            _type = Type.DrawIndirect;
+            _drawIndirect = drawIndirect;
+        }
+
+        private CommandBufferCmd(DrawTransient drawTransient) : this()
+        {
+            _type = Type.DrawTransient;
+            _drawTransient = drawTransient;
+        }
+
+        private CommandBufferCmd(DrawIndexedTransient drawIndexedTransient) : this()
+        {
+            _type = Type.DrawIndexedTransient;
+            _drawIndexedTransient = drawIndexedTransient;
+        }
+
         public static implicit operator CommandBufferCmd(SetViewportScissor cmd) => new(cmd);
         public static implicit operator CommandBufferCmd(SetViewport cmd) => new(cmd);
         public static implicit operator CommandBufferCmd(SetScissor cmd) => new(cmd);
         public static implicit operator CommandBufferCmd(BindUniform cmd) => new(cmd);
         public static implicit operator CommandBufferCmd(BindTexture cmd) => new(cmd);
+        public static implicit operator CommandBufferCmd(PushConstants cmd) => new(cmd);
         public static implicit operator CommandBufferCmd(Draw cmd) => new(cmd);
+        public static implicit operator CommandBufferCmd(DrawIndexed cmd) => new(cmd);
+        public static implicit operator CommandBufferCmd(DrawIndirect cmd) => new(cmd);
+        public static implicit operator CommandBufferCmd(DrawTransient cmd) => new(cmd);
+        public static implicit operator CommandBufferCmd(DrawIndexedTransient cmd) => new(cmd);
 
         internal enum Type : ulong
         {
@@ -276,7 +654,12 @@ namespace DigBuild.Platform.Render
             SetScissor,
             BindUniform,
             BindTexture,
-            Draw
+            PushConstants,
+            Draw,
+            DrawIndexed,
+            DrawIndirect,
+            DrawTransient,
+            DrawIndexedTransient
         }
 
         internal readonly struct SetViewportScissor
@@ -335,17 +718,147 @@ namespace DigBuild.Platform.Render
             }
         }
 
+        internal readonly struct PushConstants
+        {
+            internal const int MaxSize = 128;
+
+            private readonly IntPtr _pipeline;
+            private readonly uint _offset;
+            private readonly uint _size;
+            private readonly uint _dataOffset;
+
+            internal PushConstants(IntPtr pipeline, uint offset, uint size, uint dataOffset)
+            {
+                _pipeline = pipeline;
+                _offset = offset;
+                _size = size;
+                _dataOffset = dataOffset;
+            }
+        }
+
         internal readonly struct Draw
         {
             private readonly IntPtr _pipeline;
             private readonly IntPtr _vertexBuffer;
             private readonly IntPtr _instanceBuffer;
+            private readonly uint _firstVertex;
+            private readonly uint _vertexCount;
+            private readonly uint _firstInstance;
+            private readonly uint _instanceCount;
+
+            internal Draw(
+                IntPtr pipeline, IntPtr vertexBuffer, IntPtr instanceBuffer,
+                uint firstVertex, uint vertexCount, uint firstInstance, uint instanceCount
+            )
+            {
+                _pipeline = pipeline;
+                _vertexBuffer = vertexBuffer;
+                _instanceBuffer = instanceBuffer;
+                _firstVertex = firstVertex;
+                _vertexCount = vertexCount;
+                _firstInstance = firstInstance;
+                _instanceCount = instanceCount;
+            }
+        }
+
+        internal readonly struct DrawIndexed
+        {
+            private readonly IntPtr _pipeline;
+            private readonly IntPtr _vertexBuffer;
+            private readonly IntPtr _indexBuffer;
+            private readonly IntPtr _instanceBuffer;
+            private readonly uint _firstIndex;
+            private readonly uint _indexCount;
+            private readonly int _vertexOffset;
+            private readonly uint _firstInstance;
+            private readonly uint _instanceCount;
+
+            internal DrawIndexed(
+                IntPtr pipeline, IntPtr vertexBuffer, IntPtr indexBuffer, IntPtr instanceBuffer,
+                uint firstIndex, uint indexCount, int vertexOffset, uint firstInstance, uint instanceCount
+            )
+            {
+                _pipeline = pipeline;
+                _vertexBuffer = vertexBuffer;
+                _indexBuffer = indexBuffer;
+                _instanceBuffer = instanceBuffer;
+                _firstIndex = firstIndex;
+                _indexCount = indexCount;
+                _vertexOffset = vertexOffset;
+                _firstInstance = firstInstance;
+                _instanceCount = instanceCount;
+            }
+        }
+
+        internal readonly struct DrawIndirect
+        {
+            private readonly IntPtr _pipeline;
+            private readonly IntPtr _vertexBuffer;
+            private readonly IntPtr _indexBuffer;
+            private readonly IntPtr _instanceBuffer;
+            private readonly IntPtr _indirectBuffer;
 
-            internal Draw(IntPtr pipeline, IntPtr vertexBuffer, IntPtr instanceBuffer)
+            internal DrawIndirect(IntPtr pipeline, IntPtr vertexBuffer, IntPtr indexBuffer, IntPtr instanceBuffer, IntPtr indirectBuffer)
             {
                 _pipeline = pipeline;
                 _vertexBuffer = vertexBuffer;
+                _indexBuffer = indexBuffer;
+                _instanceBuffer = instanceBuffer;
+                _indirectBuffer = indirectBuffer;
+            }
+        }
+
+        internal readonly struct DrawTransient
+        {
+            private readonly IntPtr _pipeline;
+            private readonly TransientVertexRange _vertices;
+            private readonly IntPtr _instanceBuffer;
+            private readonly uint _firstVertex;
+            private readonly uint _vertexCount;
+            private readonly uint _firstInstance;
+            private readonly uint _instanceCount;
+
+            internal DrawTransient(
+                IntPtr pipeline, TransientVertexRange vertices, IntPtr instanceBuffer,
+                uint firstVertex, uint vertexCount, uint firstInstance, uint instanceCount
+            )
+            {
+                _pipeline = pipeline;
+                _vertices = vertices;
+                _instanceBuffer = instanceBuffer;
+                _firstVertex = firstVertex;
+                _vertexCount = vertexCount;
+                _firstInstance = firstInstance;
+                _instanceCount = instanceCount;
+            }
+        }
+
+        internal readonly struct DrawIndexedTransient
+        {
+            private readonly IntPtr _pipeline;
+            private readonly TransientVertexRange _vertices;
+            private readonly IntPtr _indexBuffer;
+            private readonly IntPtr _instanceBuffer;
+            private readonly uint _firstIndex;
+            private readonly uint _indexCount;
+            private readonly int _vertexOffset;
+            private readonly uint _firstInstance;
+            private readonly uint _instanceCount;
+
+            internal DrawIndexedTransient(
+                IntPtr pipeline, TransientVertexRange vertices, IntPtr indexBuffer, IntPtr instanceBuffer,
+                uint firstIndex, uint indexCount, int vertexOffset, uint firstInstance, uint instanceCount
+            )
+            {
+                _pipeline = pipeline;
+                _vertices = vertices;
+                _indexBuffer = indexBuffer;
                 _instanceBuffer = instanceBuffer;
+                _firstIndex = firstIndex;
+                _indexCount = indexCount;
+                _vertexOffset = vertexOffset;
+                _firstInstance = firstInstance;
+                _instanceCount = instanceCount;
             }
         }
 
@@ -137,9 +137,11 @@ namespace DigBuild.Platform.Render
         /// Adds a new depth and stencil attachment.
         /// </summary>
         /// <param name="attachment">The attachment</param>
+        /// <param name="format">The depth format, which may omit the stencil</param>
         /// <returns>The builder</returns>
         public FramebufferFormatBuilder WithDepthStencilAttachment(
-            out FramebufferDepthStencilAttachment attachment
+            out FramebufferDepthStencilAttachment attachment,
+            TextureFormat format = TextureFormat.D32SFloatS8UInt
         )
         {
             _data.Attachments.Add(
@@ -147,7 +149,7 @@ namespace DigBuild.Platform.Render
                     (uint)_data.Attachments.Count
                 )
             );
-            _data.AttachmentDescriptors.Add(new AttachmentDescriptor(AttachmentType.DepthStencil, 0xFF));
+            _data.AttachmentDescriptors.Add(new AttachmentDescriptor(AttachmentType.DepthStencil, (byte) format));
             return this;
         }
 
@@ -0,0 +1,174 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using AdvancedDLSupport;
+using DigBuild.Platform.Util;
+
+namespace DigBuild.Platform.Render
+{
+    [NativeSymbols("dbp_index_buffer_", SymbolTransformationMethod.Underscore)]
+    internal interface IIndexBufferBindings
+    {
+        void Write(IntPtr instance, IntPtr data, uint indexCount);
+        void WriteRange(IntPtr instance, uint offset, IntPtr data, uint indexCount);
+        IntPtr Map(IntPtr instance, uint indexCount);
+        void Commit(IntPtr instance, uint indexCount);
+        void SetCapacityPolicy(IntPtr instance, in BufferCapacityPolicy policy);
+        void GetStats(IntPtr instance, out BufferStats stats);
+    }
+
+    /// <summary>
+    /// The size of the indices in an index buffer.
+    /// </summary>
+    public enum IndexType : byte
+    {
+        UInt16,
+        UInt32
+    }
+
+    internal static class IndexBuffer
+    {
+        internal static readonly IIndexBufferBindings Bindings = NativeLib.Get<IIndexBufferBindings>();
+
+        internal static IndexType GetIndexType<TIndex>() where TIndex : unmanaged
+        {
+            if (typeof(TIndex) == typeof(ushort))
+                return IndexType.UInt16;
+            if (typeof(TIndex) == typeof(uint))
+                return IndexType.UInt32;
+            throw new ArgumentException($"Unsupported index type: {typeof(TIndex)}. Must be ushort or uint.");
+        }
+    }
+
+    /// <summary>
+    /// An index buffer.
+    /// </summary>
+    /// <typeparam name="TIndex">The index type, either ushort or uint</typeparam>
+    public sealed class IndexBuffer<TIndex> where TIndex : unmanaged
+    {
+        internal readonly NativeHandle Handle;
+
+        internal IndexBuffer(NativeHandle handle)
+        {
+            Handle = handle;
+        }
+
+        /// <summary>
+        /// The current memory usage of the index buffer.
+        /// </summary>
+        public BufferStats Stats
+        {
+            get
+            {
+                IndexBuffer.Bindings.GetStats(Handle, out var stats);
+                return stats;
+            }
+        }
+    }
+
+    /// <summary>
+    /// An index buffer writer.
+    /// </summary>
+    /// <typeparam name="TIndex">The index type, either ushort or uint</typeparam>
+    public sealed class IndexBufferWriter<TIndex> where TIndex : unmanaged
+    {
+        internal NativeHandle Handle = null!;
+
+        /// <summary>
+        /// Writes new data to the index buffer.
+        /// </summary>
+        /// <param name="buffer">The data</param>
+        public void Write(INativeBuffer<TIndex> buffer)
+        {
+            IndexBuffer.Bindings.Write(
+                Handle,
+                buffer.Ptr,
+                buffer.Count
+            );
+        }
+
+        /// <summary>
+        /// Overwrites part of the index buffer, leaving the rest of its contents untouched.
+        /// </summary>
+        /// <param name="offset">The position of the first index to overwrite</param>
+        /// <param name="buffer">The data</param>
+        public void WriteRange(uint offset, INativeBuffer<TIndex> buffer)
+        {
+            IndexBuffer.Bindings.WriteRange(
+                Handle,
+                offset,
+                buffer.Ptr,
+                buffer.Count
+            );
+        }
+
+        /// <summary>
+        /// Maps native memory for new indices, which replace the contents of the index buffer once committed.
+        /// The memory must not be accessed after calling <see cref="Commit"/>.
+        /// </summary>
+        /// <param name="indexCount">The maximum number of indices</param>
+        /// <returns>The mapped indices</returns>
+        public unsafe Span<TIndex> Map(uint indexCount)
+        {
+            var ptr = IndexBuffer.Bindings.Map(Handle, indexCount);
+            return new Span<TIndex>(ptr.ToPointer(), (int) indexCount);
+        }
+
+        /// <summary>
+        /// Commits the indices written to the mapped memory.
+        /// </summary>
+        /// <param name="indexCount">The number of indices written</param>
+        public void Commit(uint indexCount)
+        {
+            IndexBuffer.Bindings.Commit(Handle, indexCount);
+        }
+
+        /// <summary>
+        /// Sets how the capacity of the index buffer grows and shrinks with its contents.
+        /// </summary>
+        /// <param name="policy">The policy</param>
+        public void SetCapacityPolicy(BufferCapacityPolicy policy)
+        {
+            IndexBuffer.Bindings.SetCapacityPolicy(Handle, policy);
+        }
+    }
+
+    /// <summary>
+    /// An index buffer builder.
+    /// </summary>
+    /// <typeparam name="TIndex">The index type, either ushort or uint</typeparam>
+    public readonly ref struct IndexBufferBuilder<TIndex> where TIndex : unmanaged
+    {
+        private readonly RenderContext _ctx;
+        private readonly INativeBuffer<TIndex>? _initialData;
+        private readonly IndexBufferWriter<TIndex>? _writer;
+
+        internal IndexBufferBuilder(RenderContext ctx, INativeBuffer<TIndex>? initialData)
+        {
+            _ctx = ctx;
+            _initialData = initialData;
+            _writer = null;
+        }
+        internal IndexBufferBuilder(RenderContext ctx, INativeBuffer<TIndex>? initialData, out IndexBufferWriter<TIndex> writer)
+        {
+            _ctx = ctx;
+            _initialData = initialData;
+            _writer = writer = new IndexBufferWriter<TIndex>();
+        }
+
+        public static implicit operator IndexBuffer<TIndex>(IndexBufferBuilder<TIndex> builder)
+        {
+            var handle = new NativeHandle(
+                RenderContext.Bindings.CreateIndexBuffer(
+                    builder._ctx.Ptr,
+                    builder._initialData?.Ptr ?? IntPtr.Zero,
+                    builder._initialData?.Count ?? 0,
+                    IndexBuffer.GetIndexType<TIndex>(),
+                    builder._writer != null
+                )
+            );
+            if (builder._writer != null)
+                builder._writer.Handle = handle;
+            return new IndexBuffer<TIndex>(handle);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+﻿using System;
+using AdvancedDLSupport;
+using DigBuild.Platform.Util;
+
+namespace DigBuild.Platform.Render
+{
+    [NativeSymbols("dbp_indirect_draw_buffer_", SymbolTransformationMethod.Underscore)]
+    internal interface IIndirectDrawBufferBindings
+    {
+        void Write(IntPtr instance, IntPtr data, uint commandCount);
+        void WriteRange(IntPtr instance, uint offset, IntPtr data, uint commandCount);
+        void SetDrawCount(IntPtr instance, uint drawCount);
+        void SetCapacityPolicy(IntPtr instance, in BufferCapacityPolicy policy);
+        void GetStats(IntPtr instance, out BufferStats stats);
+    }
+
+    /// <summary>
+    /// A non-indexed draw, as read by the GPU from an indirect draw buffer.
+    /// </summary>
+    public readonly struct DrawIndirectCommand
+    {
+        /// <summary>
+        /// The number of vertices to draw.
+        /// </summary>
+        public readonly uint VertexCount;
+        /// <summary>
+        /// The number of instances to draw.
+        /// </summary>
+        public readonly uint InstanceCount;
+        /// <summary>
+        /// The index of the first vertex to draw.
+        /// </summary>
+        public readonly uint FirstVertex;
+        /// <summary>
+        /// The index of the first instance to draw.
+        /// </summary>
+        public readonly uint FirstInstance;
+
+        public DrawIndirectCommand(uint vertexCount, uint instanceCount = 1, uint firstVertex = 0, uint firstInstance = 0)
+        {
+            VertexCount = vertexCount;
+            InstanceCount = instanceCount;
+            FirstVertex = firstVertex;
+            FirstInstance = firstInstance;
+        }
+    }
+
+    /// <summary>
+    /// An indexed draw, as read by the GPU from an indirect draw buffer.
+    /// </summary>
+    public readonly struct DrawIndexedIndirectCommand
+    {
+        /// <summary>
+        /// The number of indices to draw.
+        /// </summary>
+        public readonly uint IndexCount;
+        /// <summary>
+        /// The number of instances to draw.
+        /// </summary>
+        public readonly uint InstanceCount;
+        /// <summary>
+        /// The position of the first index to draw.
+        /// </summary>
+        public readonly uint FirstIndex;
+        /// <summary>
+        /// The value added to each index before reading the vertex.
+        /// </summary>
+        public readonly int VertexOffset;
+        /// <summary>
+        /// The index of the first instance to draw.
+        /// </summary>
+        public readonly uint FirstInstance;
+
+        public DrawIndexedIndirectCommand(uint indexCount, uint instanceCount = 1, uint firstIndex = 0, int vertexOffset = 0, uint firstInstance = 0)
+        {
+            IndexCount = indexCount;
+            InstanceCount = instanceCount;
+            FirstIndex = firstIndex;
+            VertexOffset = vertexOffset;
+            FirstInstance = firstInstance;
+        }
+    }
+
+    internal static class IndirectDrawBuffer
+    {
+        internal static readonly IIndirectDrawBufferBindings Bindings = NativeLib.Get<IIndirectDrawBufferBindings>();
+
+        internal static bool IsIndexed<TCommand>() where TCommand : unmanaged
+        {
+            if (typeof(TCommand) == typeof(DrawIndirectCommand))
+                return false;
+            if (typeof(TCommand) == typeof(DrawIndexedIndirectCommand))
+                return true;
+            throw new ArgumentException($"Unsupported draw command type: {typeof(TCommand)}. Must be DrawIndirectCommand or DrawIndexedIndirectCommand.");
+        }
+    }
+
+    /// <summary>
+    /// A GPU buffer of draw commands, all of which are issued by a single indirect draw.
+    /// </summary>
+    /// <typeparam name="TCommand">The command type, either DrawIndirectCommand or DrawIndexedIndirectCommand</typeparam>
+    public sealed class IndirectDrawBuffer<TCommand> where TCommand : unmanaged
+    {
+        internal readonly NativeHandle Handle;
+
+        internal IndirectDrawBuffer(NativeHandle handle)
+        {
+            Handle = handle;
+        }
+
+        /// <summary>
+        /// Replaces all draw commands, and draws all of them.
+        /// </summary>
+        /// <param name="buffer">The commands</param>
+        public void Write(INativeBuffer<TCommand> buffer)
+        {
+            IndirectDrawBuffer.Bindings.Write(
+                Handle,
+                buffer.Ptr,
+                buffer.Count
+            );
+        }
+
+        /// <summary>
+        /// Overwrites some of the draw commands, leaving the rest untouched.
+        /// </summary>
+        /// <param name="offset">The index of the first command to overwrite</param>
+        /// <param name="buffer">The commands</param>
+        public void WriteRange(uint offset, INativeBuffer<TCommand> buffer)
+        {
+            IndirectDrawBuffer.Bindings.WriteRange(
+                Handle,
+                offset,
+                buffer.Ptr,
+                buffer.Count
+            );
+        }
+
+        /// <summary>
+        /// Limits drawing to the first commands, without rewriting them.
+        /// </summary>
+        /// <param name="drawCount">The number of commands to draw</param>
+        public void SetDrawCount(uint drawCount)
+        {
+            IndirectDrawBuffer.Bindings.SetDrawCount(Handle, drawCount);
+        }
+
+        /// <summary>
+        /// Sets how the capacity of the buffer grows and shrinks with its contents.
+        /// </summary>
+        /// <param name="policy">The policy</param>
+        public void SetCapacityPolicy(BufferCapacityPolicy policy)
+        {
+            IndirectDrawBuffer.Bindings.SetCapacityPolicy(Handle, policy);
+        }
+
+        /// <summary>
+        /// The current memory usage of the buffer.
+        /// </summary>
+        public BufferStats Stats
+        {
+            get
+            {
+                IndirectDrawBuffer.Bindings.GetStats(Handle, out var stats);
+                return stats;
+            }
+        }
+    }
+
+    /// <summary>
+    /// An indirect draw buffer builder.
+    /// </summary>
+    /// <typeparam name="TCommand">The command type, either DrawIndirectCommand or DrawIndexedIndirectCommand</typeparam>
+    public readonly ref struct IndirectDrawBufferBuilder<TCommand> where TCommand : unmanaged
+    {
+        private readonly RenderContext _ctx;
+        private readonly INativeBuffer<TCommand>? _initialData;
+
+        internal IndirectDrawBufferBuilder(RenderContext ctx, INativeBuffer<TCommand>? initialData)
+        {
+            _ctx = ctx;
+            _initialData = initialData;
+        }
+
+        public static implicit operator IndirectDrawBuffer<TCommand>(IndirectDrawBufferBuilder<TCommand> builder)
+        {
+            return new(
+                new NativeHandle(
+                    RenderContext.Bindings.CreateIndirectDrawBuffer(
+                        builder._ctx.Ptr,
+                        builder._initialData?.Ptr ?? IntPtr.Zero,
+                        builder._initialData?.Count ?? 0,
+                        IndirectDrawBuffer.IsIndexed<TCommand>()
+                    )
+                )
+            );
+        }
+    }
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Drawing;
 using System.Drawing.Imaging;
+using System.Runtime.InteropServices;
 using AdvancedDLSupport;
 using DigBuild.Platform.Resource;
 using DigBuild.Platform.Util;
@@ -36,6 +38,7 @@ namespace DigBuild.Platform.Render
             IntPtr blendOptions,
             IntPtr vertexShader,
             IntPtr fragmentShader,
+            IntPtr pushConstants, uint pushConstantCount,
             Topology topology,
             RasterMode rasterMode,
             bool discardRaster,
@@ -64,6 +67,19 @@ namespace DigBuild.Platform.Render
             bool writable
         );
 
+        IntPtr CreateIndexBuffer(
+            IntPtr instance,
+            IntPtr data, uint indexCount,
+            IndexType indexType,
+            bool writable
+        );
+
+        IntPtr CreateIndirectDrawBuffer(
+            IntPtr instance,
+            IntPtr data, uint commandCount,
+            bool indexed
+        );
+
         IntPtr CreateTextureSampler(
             IntPtr instance,
             TextureFiltering minFiltering,
@@ -71,7 +87,11 @@ namespace DigBuild.Platform.Render
             TextureWrapping wrapping,
             TextureBorderColor borderColor,
             bool enableAnisotropy,
-            uint anisotropyLevel
+            uint anisotropyLevel,
+            TextureMipmapMode mipmapMode,
+            float minLod,
+            float maxLod,
+            float lodBias
         );
         IntPtr CreateTextureBinding(
             IntPtr instance,
@@ -82,12 +102,46 @@ namespace DigBuild.Platform.Render
         IntPtr CreateTexture(
             IntPtr instance,
             uint width, uint height,
+            TextureFormat format,
+            IntPtr dataStart, uint dataLength,
+            TextureMipmaps mipmaps, uint mipLevels
+        );
+        IntPtr CreateTextureArray(
+            IntPtr instance,
+            uint width, uint height, uint layers,
+            TextureFormat format,
+            IntPtr dataStart, uint dataLength,
+            TextureMipmaps mipmaps, uint mipLevels
+        );
+        IntPtr CreateDynamicTexture(
+            IntPtr instance,
+            uint width, uint height,
+            TextureFormat format,
             IntPtr dataStart, uint dataLength
         );
+        public delegate void TextureReadyCallback();
+        IntPtr CreateTextureAsync(
+            IntPtr instance,
+            uint width, uint height,
+            TextureFormat format,
+            IntPtr dataStart, uint dataLength,
+            TextureMipmaps mipmaps, uint mipLevels,
+            TextureReadyCallback? callback
+        );
 
         IntPtr CreateCommandBuffer(IntPtr instance);
 
         void Enqueue(IntPtr instance, IntPtr renderTarget, IntPtr commandBuffer);
+
+        bool IsTextureFormatSupported(IntPtr instance, TextureFormat format);
+
+        bool IsAttachmentFormatSupported(IntPtr instance, TextureFormat format);
+
+        void GetStagingStats(IntPtr instance, out StagingStats stats);
+
+        IntPtr AllocateTransientVertices(IntPtr instance, uint vertexCount, uint vertexSize, out TransientVertexRange range);
+
+        void GetTransientVertexStats(IntPtr instance, out StagingStats stats);
     }
 
     /// <summary>
@@ -238,6 +292,69 @@ namespace DigBuild.Platform.Render
         ) where TVertex : unmanaged
             => new(this, initialData, out writer);
 
+        /// <summary>
+        /// Creates a new index buffer builder.
+        /// </summary>
+        /// <typeparam name="TIndex">The index type, either ushort or uint</typeparam>
+        /// <param name="initialData">The initial data</param>
+        /// <returns>The builder</returns>
+        public IndexBufferBuilder<TIndex> CreateIndexBuffer<TIndex>(
+            INativeBuffer<TIndex> initialData
+        ) where TIndex : unmanaged
+            => new(this, initialData);
+
+        /// <summary>
+        /// Creates a new index buffer.
+        /// </summary>
+        /// <typeparam name="TIndex">The index type, either ushort or uint</typeparam>
+        /// <param name="initialData">The initial data</param>
+        /// <returns>The buffer</returns>
+        public IndexBuffer<TIndex> CreateIndexBuffer<TIndex>(
+            params TIndex[] initialData
+        ) where TIndex : unmanaged
+        {
+            using var buf = new NativeBuffer<TIndex>((uint) initialData.Length) {initialData};
+            return new IndexBufferBuilder<TIndex>(this, buf);
+        }
+
+        /// <summary>
+        /// Creates a new index buffer builder with a writer.
+        /// </summary>
+        /// <typeparam name="TIndex">The index type, either ushort or uint</typeparam>
+        /// <param name="writer">The writer</param>
+        /// <param name="initialData">The inital data</param>
+        /// <returns>The builder</returns>
+        public IndexBufferBuilder<TIndex> CreateIndexBuffer<TIndex>(
+            out IndexBufferWriter<TIndex> writer,
+            INativeBuffer<TIndex>? initialData = null
+        ) where TIndex : unmanaged
+            => new(this, initialData, out writer);
+
+        /// <summary>
+        /// Creates a new indirect draw buffer builder.
+        /// </summary>
+        /// <typeparam name="TCommand">The command type, either DrawIndirectCommand or DrawIndexedIndirectCommand</typeparam>
+        /// <param name="initialData">The initial commands</param>
+        /// <returns>The builder</returns>
+        public IndirectDrawBufferBuilder<TCommand> CreateIndirectDrawBuffer<TCommand>(
+            INativeBuffer<TCommand>? initialData = null
+        ) where TCommand : unmanaged
+            => new(this, initialData);
+
+        /// <summary>
+        /// Creates a new indirect draw buffer.
+        /// </summary>
+        /// <typeparam name="TCommand">The command type, either DrawIndirectCommand or DrawIndexedIndirectCommand</typeparam>
+        /// <param name="initialData">The initial commands</param>
+        /// <returns>The buffer</returns>
+        public IndirectDrawBuffer<TCommand> CreateIndirectDrawBuffer<TCommand>(
+            params TCommand[] initialData
+        ) where TCommand : unmanaged
+        {
+            using var buf = new NativeBuffer<TCommand>((uint) initialData.Length) {initialData};
+            return new IndirectDrawBufferBuilder<TCommand>(this, buf);
+        }
+
         /// <summary>
         /// Creates a uniform binding builder.
         /// </summary>
@@ -311,9 +428,13 @@ namespace DigBuild.Platform.Render
         /// Creates a new texture.
         /// </summary>
         /// <param name="image">The image</param>
+        /// <param name="generateMipmaps">Whether to generate mip levels from the image on the GPU</param>
+        /// <param name="mipLevels">The number of mip levels to generate, including the image itself</param>
         /// <returns>The texture</returns>
         public Texture CreateTexture(
-            Bitmap image
+            Bitmap image,
+            bool generateMipmaps = false,
+            uint mipLevels = Texture.FullMipChain
         )
         {
             var data = image.LockBits(
@@ -327,15 +448,268 @@ namespace DigBuild.Platform.Render
                 Bindings.CreateTexture(
                     Ptr,
                     (uint) image.Width, (uint)image.Height,
+                    TextureFormat.B8G8R8A8SRGB,
+                    data.Scan0, length,
+                    generateMipmaps ? TextureMipmaps.Generate : TextureMipmaps.None, mipLevels
+                )
+            ));
+            
+            image.UnlockBits(data);
+
+            return texture;
+        }
+
+        /// <summary>
+        /// Creates a new texture from precomputed mip levels.
+        /// </summary>
+        /// <param name="mipLevels">The images for each mip level, starting with the full size one and halving in size each level</param>
+        /// <returns>The texture</returns>
+        public unsafe Texture CreateTexture(
+            IReadOnlyList<Bitmap> mipLevels
+        )
+        {
+            if (mipLevels.Count == 0)
+                throw new ArgumentException("At least one mip level is required.", nameof(mipLevels));
+
+            var data = ReadImages(mipLevels);
+            fixed (byte* ptr = data)
+            {
+                return new Texture(new NativeHandle(
+                    Bindings.CreateTexture(
+                        Ptr,
+                        (uint) mipLevels[0].Width, (uint) mipLevels[0].Height,
+                        TextureFormat.B8G8R8A8SRGB,
+                        new IntPtr(ptr), (uint) data.Length,
+                        TextureMipmaps.Precomputed, (uint) mipLevels.Count
+                    )
+                ));
+            }
+        }
+
+        /// <summary>
+        /// Creates a new texture from raw data in the given format, such as pre-compressed block data.
+        /// </summary>
+        /// <param name="format">The format</param>
+        /// <param name="width">The width</param>
+        /// <param name="height">The height</param>
+        /// <param name="data">The data, holding every mip level back to back, largest first</param>
+        /// <param name="mipLevels">The number of mip levels in the data</param>
+        /// <returns>The texture</returns>
+        public unsafe Texture CreateTexture(
+            TextureFormat format,
+            uint width, uint height,
+            ReadOnlySpan<byte> data,
+            uint mipLevels = 1
+        )
+        {
+            fixed (byte* ptr = data)
+            {
+                return new Texture(new NativeHandle(
+                    Bindings.CreateTexture(
+                        Ptr,
+                        width, height,
+                        format,
+                        new IntPtr(ptr), (uint) data.Length,
+                        mipLevels > 1 ? TextureMipmaps.Precomputed : TextureMipmaps.None, mipLevels
+                    )
+                ));
+            }
+        }
+
+        /// <summary>
+        /// Creates a new texture array, with one layer per image.
+        /// </summary>
+        /// <param name="layers">The images for each layer, all of the same size</param>
+        /// <param name="generateMipmaps">Whether to generate mip levels from the images on the GPU</param>
+        /// <param name="mipLevels">The number of mip levels to generate, including the images themselves</param>
+        /// <returns>The texture</returns>
+        public unsafe Texture CreateTextureArray(
+            IReadOnlyList<Bitmap> layers,
+            bool generateMipmaps = false,
+            uint mipLevels = Texture.FullMipChain
+        )
+        {
+            if (layers.Count == 0)
+                throw new ArgumentException("At least one layer is required.", nameof(layers));
+
+            var data = ReadImages(layers);
+            fixed (byte* ptr = data)
+            {
+                return new Texture(new NativeHandle(
+                    Bindings.CreateTextureArray(
+                        Ptr,
+                        (uint) layers[0].Width, (uint) layers[0].Height, (uint) layers.Count,
+                        TextureFormat.B8G8R8A8SRGB,
+                        new IntPtr(ptr), (uint) data.Length,
+                        generateMipmaps ? TextureMipmaps.Generate : TextureMipmaps.None, mipLevels
+                    )
+                ));
+            }
+        }
+
+        /// <summary>
+        /// Creates a new texture array from precomputed mip levels, with one layer per list of images.
+        /// </summary>
+        /// <param name="layers">The mip levels for each layer, starting with the full size one and halving in size each level</param>
+        /// <returns>The texture</returns>
+        public unsafe Texture CreateTextureArray(
+            IReadOnlyList<IReadOnlyList<Bitmap>> layers
+        )
+        {
+            if (layers.Count == 0 || layers[0].Count == 0)
+                throw new ArgumentException("At least one layer and mip level is required.", nameof(layers));
+
+            var images = new List<Bitmap>();
+            foreach (var layer in layers)
+            {
+                if (layer.Count != layers[0].Count)
+                    throw new ArgumentException("All layers must have the same number of mip levels.", nameof(layers));
+                images.AddRange(layer);
+            }
+
+            var data = ReadImages(images);
+            fixed (byte* ptr = data)
+            {
+                return new Texture(new NativeHandle(
+                    Bindings.CreateTextureArray(
+                        Ptr,
+                        (uint) layers[0][0].Width, (uint) layers[0][0].Height, (uint) layers.Count,
+                        TextureFormat.B8G8R8A8SRGB,
+                        new IntPtr(ptr), (uint) data.Length,
+                        TextureMipmaps.Precomputed, (uint) layers[0].Count
+                    )
+                ));
+            }
+        }
+
+        /// <summary>
+        /// Creates a new dynamic texture, whose contents can be replaced every update.
+        /// Texture bindings pick up the new contents without being updated.
+        /// </summary>
+        /// <param name="width">The width</param>
+        /// <param name="height">The height</param>
+        /// <param name="format">The format</param>
+        /// <returns>The texture</returns>
+        public Texture CreateDynamicTexture(
+            uint width, uint height,
+            TextureFormat format = TextureFormat.B8G8R8A8SRGB
+        )
+        {
+            return new Texture(new NativeHandle(
+                Bindings.CreateDynamicTexture(
+                    Ptr,
+                    width, height,
+                    format,
+                    IntPtr.Zero, 0
+                )
+            ));
+        }
+
+        /// <summary>
+        /// Creates a new dynamic texture from an image, whose contents can be replaced every update.
+        /// Texture bindings pick up the new contents without being updated.
+        /// </summary>
+        /// <param name="image">The initial image</param>
+        /// <returns>The texture</returns>
+        public Texture CreateDynamicTexture(
+            Bitmap image
+        )
+        {
+            var data = image.LockBits(
+                new Rectangle(0, 0, image.Width, image.Height),
+                ImageLockMode.ReadOnly,
+                PixelFormat.Format32bppArgb
+            );
+            var length = (uint) (Math.Abs(data.Stride) * image.Height);
+
+            var texture = new Texture(new NativeHandle(
+                Bindings.CreateDynamicTexture(
+                    Ptr,
+                    (uint) image.Width, (uint) image.Height,
+                    TextureFormat.B8G8R8A8SRGB,
                     data.Scan0, length
                 )
             ));
+
+            image.UnlockBits(data);
+
+            return texture;
+        }
+
+        /// <summary>
+        /// Creates a new texture without waiting for its data to be uploaded.
+        /// The texture can be bound right away, and samples as a placeholder until <see cref="Texture.IsReady"/>.
+        /// </summary>
+        /// <param name="image">The image</param>
+        /// <param name="onReady">An optional callback, invoked during a later update once the upload has finished</param>
+        /// <param name="generateMipmaps">Whether to generate mip levels from the image on the GPU</param>
+        /// <param name="mipLevels">The number of mip levels to generate, including the image itself</param>
+        /// <returns>The texture</returns>
+        public Texture CreateTextureAsync(
+            Bitmap image,
+            Action<Texture>? onReady = null,
+            bool generateMipmaps = false,
+            uint mipLevels = Texture.FullMipChain
+        )
+        {
+            var data = image.LockBits(
+                new Rectangle(0, 0, image.Width, image.Height),
+                ImageLockMode.ReadOnly,
+                PixelFormat.Format32bppArgb
+            );
+            var length = (uint) (Math.Abs(data.Stride) * image.Height);
+
+            Texture? texture = null;
+            IRenderContextBindings.TextureReadyCallback? callback = null;
+            callback = () =>
+            {
+                lock (Texture.PendingReadyCallbacks)
+                    Texture.PendingReadyCallbacks.Remove(callback!);
+                onReady?.Invoke(texture!);
+            };
+            lock (Texture.PendingReadyCallbacks)
+                Texture.PendingReadyCallbacks.Add(callback);
+
+            texture = new Texture(new NativeHandle(
+                Bindings.CreateTextureAsync(
+                    Ptr,
+                    (uint) image.Width, (uint)image.Height,
+                    TextureFormat.B8G8R8A8SRGB,
+                    data.Scan0, length,
+                    generateMipmaps ? TextureMipmaps.Generate : TextureMipmaps.None, mipLevels,
+                    callback
+                )
+            ));
             
             image.UnlockBits(data);
 
             return texture;
         }
 
+        private static byte[] ReadImages(IReadOnlyList<Bitmap> images)
+        {
+            var length = 0;
+            foreach (var image in images)
+                length += image.Width * image.Height * 4;
+
+            var bytes = new byte[length];
+            var offset = 0;
+            foreach (var image in images)
+            {
+                var data = image.LockBits(
+                    new Rectangle(0, 0, image.Width, image.Height),
+                    ImageLockMode.ReadOnly,
+                    PixelFormat.Format32bppArgb
+                );
+                var levelLength = image.Width * image.Height * 4;
+                Marshal.Copy(data.Scan0, bytes, offset, levelLength);
+                offset += levelLength;
+                image.UnlockBits(data);
+            }
+
+            return bytes;
+        }
+
         /// <summary>
         /// Creates a new command buffer builder.
         /// </summary>
@@ -352,5 +726,95 @@ namespace DigBuild.Platform.Render
             IRenderTarget target,
             CommandBuffer cmd
         ) => Bindings.Enqueue(Ptr, target.Handle, cmd.Handle);
+
+        /// <summary>
+        /// Checks whether textures of the given format can be created and sampled on this device.
+        /// </summary>
+        /// <param name="format">The format</param>
+        /// <returns>Whether the format is supported</returns>
+        public bool IsTextureFormatSupported(TextureFormat format) => Bindings.IsTextureFormatSupported(Ptr, format);
+
+        /// <summary>
+        /// Checks whether framebuffer attachments of the given format can be rendered to and sampled on this device.
+        /// Depth formats are checked as depth attachments, all others as color attachments.
+        /// </summary>
+        /// <param name="format">The format</param>
+        /// <returns>Whether the format is supported</returns>
+        public bool IsAttachmentFormatSupported(TextureFormat format) => Bindings.IsAttachmentFormatSupported(Ptr, format);
+
+        /// <summary>
+        /// The current usage of the memory that uploads are staged through.
+        /// </summary>
+        public StagingStats StagingStats
+        {
+            get
+            {
+                Bindings.GetStagingStats(Ptr, out var stats);
+                return stats;
+            }
+        }
+
+        /// <summary>
+        /// Allocates vertices for the current frame, for geometry that is rebuilt every frame such as UI or particles.
+        /// The vertices are written directly to memory the GPU reads from, and are recycled once the frame has finished.
+        /// The vertices can only be drawn by command buffers committed before the next update, and the memory must not be
+        /// accessed after it. Allocating them creates no objects, so it is cheap to do many times per frame.
+        /// </summary>
+        /// <typeparam name="TVertex">The vertex format</typeparam>
+        /// <param name="vertexCount">The number of vertices</param>
+        /// <param name="vertices">The mapped vertices</param>
+        /// <returns>The transient vertices</returns>
+        public unsafe TransientVertices<TVertex> AllocateTransientVertices<TVertex>(
+            uint vertexCount,
+            out Span<TVertex> vertices
+        ) where TVertex : unmanaged
+        {
+            var data = Bindings.AllocateTransientVertices(Ptr, vertexCount, (uint) sizeof(TVertex), out var range);
+            vertices = new Span<TVertex>(data.ToPointer(), (int) vertexCount);
+            return new TransientVertices<TVertex>(range, vertexCount);
+        }
+
+        /// <summary>
+        /// The current usage of the memory that transient vertices are allocated from.
+        /// </summary>
+        public StagingStats TransientVertexStats
+        {
+            get
+            {
+                Bindings.GetTransientVertexStats(Ptr, out var stats);
+                return stats;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Usage statistics of the memory that uploads are staged through.
+    /// </summary>
+    public readonly struct StagingStats
+    {
+        /// <summary>
+        /// The total size of all regular staging chunks, in bytes.
+        /// </summary>
+        public readonly ulong Capacity;
+        /// <summary>
+        /// The amount of staging memory used by frames still in flight, in bytes.
+        /// </summary>
+        public readonly ulong Used;
+        /// <summary>
+        /// The highest amount of staging memory ever in use at once, in bytes.
+        /// </summary>
+        public readonly ulong PeakUsed;
+        /// <summary>
+        /// The number of regular staging chunks.
+        /// </summary>
+        public readonly uint ChunkCount;
+        /// <summary>
+        /// The number of dedicated chunks created for uploads larger than a regular chunk and still in flight.
+        /// </summary>
+        public readonly uint DedicatedChunkCount;
+        /// <summary>
+        /// The number of regular chunks placed in device memory that is written to directly.
+        /// </summary>
+        public readonly uint DirectChunkCount;
     }
 }
\ No newline at end of file
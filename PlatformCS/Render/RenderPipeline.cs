@@ -1,4 +1,6 @@
 ﻿using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
 using DigBuild.Platform.Util;
 
 namespace DigBuild.Platform.Render
@@ -70,6 +72,7 @@ namespace DigBuild.Platform.Render
             internal readonly FormatDescriptor? InstanceDescriptor;
             internal readonly Func<NativeHandle, TPipeline> Factory;
             internal readonly BlendOptions[] BlendOptions;
+            internal readonly List<PushConstantRange> PushConstants = new();
 
             internal Data(
                 VertexShader vertexShader,
@@ -348,6 +351,32 @@ namespace DigBuild.Platform.Render
             return this;
         }
 
+        /// <summary>
+        /// Declares a range of push constant data, which the given shader stages can read.
+        /// </summary>
+        /// <param name="stages">The shader stages</param>
+        /// <param name="offset">The offset of the range, in bytes</param>
+        /// <param name="size">The size of the range, in bytes</param>
+        /// <returns>The builder</returns>
+        public RenderPipelineBuilder<TPipeline> WithPushConstants(ShaderStages stages, uint offset, uint size)
+        {
+            if (offset + size > CommandBufferRecorder.MaxPushConstantsSize)
+                throw new ArgumentException($"Push constants cannot exceed {CommandBufferRecorder.MaxPushConstantsSize} bytes.");
+            _data.PushConstants.Add(new PushConstantRange(stages, offset, size));
+            return this;
+        }
+
+        /// <summary>
+        /// Declares a range of push constant data the size of the given type, which the given shader stages can read.
+        /// </summary>
+        /// <typeparam name="T">The push constant type</typeparam>
+        /// <param name="stages">The shader stages</param>
+        /// <param name="offset">The offset of the range, in bytes</param>
+        /// <returns>The builder</returns>
+        public RenderPipelineBuilder<TPipeline> WithPushConstants<T>(ShaderStages stages, uint offset = 0)
+            where T : unmanaged
+            => WithPushConstants(stages, offset, (uint) Unsafe.SizeOf<T>());
+
         public static unsafe implicit operator TPipeline(RenderPipelineBuilder<TPipeline> builder)
         {
             var data = builder._data;
@@ -357,10 +386,12 @@ namespace DigBuild.Platform.Render
                 new Span<FormatDescriptor.Element>(data.InstanceDescriptor.Elements) :
                 Span<FormatDescriptor.Element>.Empty;
             var span3 = new Span<BlendOptions>(data.BlendOptions);
+            var span4 = new Span<PushConstantRange>(data.PushConstants.ToArray());
 
             fixed (FormatDescriptor.Element* p1 = &span1.GetPinnableReference())
             fixed (FormatDescriptor.Element* p2 = &span2.GetPinnableReference())
             fixed (BlendOptions* p3 = &span3.GetPinnableReference())
+            fixed (PushConstantRange* p4 = &span4.GetPinnableReference())
             {
                 var handle = new NativeHandle(
                     RenderContext.Bindings.CreateRenderPipeline(
@@ -372,6 +403,7 @@ namespace DigBuild.Platform.Render
                         new IntPtr(p3),
                         data.VertexShader.Handle,
                         data.FragmentShader.Handle,
+                        new IntPtr(p4), (uint) span4.Length,
                         data.Topology,
                         data.RasterMode,
                         data.DiscardRaster,
@@ -393,6 +425,20 @@ namespace DigBuild.Platform.Render
             }
         }
 
+        private readonly struct PushConstantRange
+        {
+            private readonly ShaderStages _stages;
+            private readonly uint _offset;
+            private readonly uint _size;
+
+            internal PushConstantRange(ShaderStages stages, uint offset, uint size)
+            {
+                _stages = stages;
+                _offset = offset;
+                _size = size;
+            }
+        }
+
         private struct BlendOptions
         {
             internal bool Enabled;
@@ -159,6 +159,16 @@ namespace DigBuild.Platform.Render
         Vertex, Fragment
     }
 
+    /// <summary>
+    /// A set of shader stages.
+    /// </summary>
+    [Flags]
+    public enum ShaderStages : byte
+    {
+        Vertex = 1 << 0,
+        Fragment = 1 << 1
+    }
+
     /// <summary>
     /// A shader builder.
     /// </summary>
@@ -1,4 +1,7 @@
 ﻿using System;
+using System.Collections.Generic;
+using System.Drawing;
+using System.Drawing.Imaging;
 using AdvancedDLSupport;
 using DigBuild.Platform.Util;
 
@@ -9,6 +12,11 @@ namespace DigBuild.Platform.Render
     {
         uint GetWidth(IntPtr instance);
         uint GetHeight(IntPtr instance);
+        uint GetLayers(IntPtr instance);
+        uint GetMipLevels(IntPtr instance);
+        bool IsReady(IntPtr instance);
+        void Write(IntPtr instance, IntPtr data, uint dataLength);
+        void WriteRegion(IntPtr instance, uint x, uint y, uint width, uint height, uint layer, uint mipLevel, IntPtr data, uint dataLength);
     }
 
     /// <summary>
@@ -18,6 +26,14 @@ namespace DigBuild.Platform.Render
     {
         internal static readonly ITextureBindings Bindings = NativeLib.Get<ITextureBindings>();
 
+        /// <summary>
+        /// A mip level count that requests every level down to 1x1.
+        /// </summary>
+        public const uint FullMipChain = 0;
+
+        // Callbacks handed to native code must stay alive until they have been invoked
+        internal static readonly HashSet<Delegate> PendingReadyCallbacks = new();
+
         internal readonly NativeHandle Handle;
 
         internal Texture(NativeHandle handle)
@@ -35,6 +51,92 @@ namespace DigBuild.Platform.Render
         /// The height.
         /// </summary>
         public uint Height => Bindings.GetHeight(Handle);
+        /// <summary>
+        /// The number of layers, which is only ever more than one for texture arrays.
+        /// </summary>
+        public uint Layers => Bindings.GetLayers(Handle);
+        /// <summary>
+        /// The number of mip levels.
+        /// </summary>
+        public uint MipLevels => Bindings.GetMipLevels(Handle);
+        /// <summary>
+        /// Whether the texture data has finished uploading. Until then, sampling it yields a placeholder.
+        /// </summary>
+        public bool IsReady => Bindings.IsReady(Handle);
+
+        /// <summary>
+        /// Replaces the contents of a dynamic texture. Writes that cover an earlier write of the same update replace it.
+        /// </summary>
+        /// <param name="data">The data, of the same size and format as the texture</param>
+        public unsafe void Write(ReadOnlySpan<byte> data)
+        {
+            fixed (byte* ptr = data)
+                Bindings.Write(Handle, new IntPtr(ptr), (uint) data.Length);
+        }
+
+        /// <summary>
+        /// Replaces the contents of a dynamic texture with an image. Writes that cover an earlier write of the same update replace it.
+        /// </summary>
+        /// <param name="image">The image, of the same size as the texture</param>
+        public void Write(Bitmap image)
+        {
+            var data = image.LockBits(
+                new Rectangle(0, 0, image.Width, image.Height),
+                ImageLockMode.ReadOnly,
+                PixelFormat.Format32bppArgb
+            );
+            var length = (uint) (Math.Abs(data.Stride) * image.Height);
+            Bindings.Write(Handle, data.Scan0, length);
+            image.UnlockBits(data);
+        }
+
+        /// <summary>
+        /// Replaces a region of the texture. All region writes to a texture within an update are uploaded together.
+        /// Mip levels are not regenerated from the written data.
+        /// </summary>
+        /// <param name="x">The left edge of the region</param>
+        /// <param name="y">The top edge of the region</param>
+        /// <param name="width">The width of the region</param>
+        /// <param name="height">The height of the region</param>
+        /// <param name="data">The data, of the size of the region and the format of the texture</param>
+        /// <param name="layer">The layer</param>
+        /// <param name="mipLevel">The mip level</param>
+        public unsafe void WriteRegion(uint x, uint y, uint width, uint height, ReadOnlySpan<byte> data, uint layer = 0, uint mipLevel = 0)
+        {
+            fixed (byte* ptr = data)
+                Bindings.WriteRegion(Handle, x, y, width, height, layer, mipLevel, new IntPtr(ptr), (uint) data.Length);
+        }
+
+        /// <summary>
+        /// Replaces a region of the texture with an image. All region writes to a texture within an update are uploaded together.
+        /// Mip levels are not regenerated from the written data.
+        /// </summary>
+        /// <param name="x">The left edge of the region</param>
+        /// <param name="y">The top edge of the region</param>
+        /// <param name="image">The image</param>
+        /// <param name="layer">The layer</param>
+        /// <param name="mipLevel">The mip level</param>
+        public void WriteRegion(uint x, uint y, Bitmap image, uint layer = 0, uint mipLevel = 0)
+        {
+            var data = image.LockBits(
+                new Rectangle(0, 0, image.Width, image.Height),
+                ImageLockMode.ReadOnly,
+                PixelFormat.Format32bppArgb
+            );
+            var length = (uint) (Math.Abs(data.Stride) * image.Height);
+            Bindings.WriteRegion(Handle, x, y, (uint) image.Width, (uint) image.Height, layer, mipLevel, data.Scan0, length);
+            image.UnlockBits(data);
+        }
+    }
+
+    /// <summary>
+    /// The source of a texture's mip levels.
+    /// </summary>
+    internal enum TextureMipmaps : byte
+    {
+        None,
+        Generate,
+        Precomputed
     }
 
     /// <summary>
@@ -44,6 +146,31 @@ namespace DigBuild.Platform.Render
     {
         R8G8B8A8SRGB,
         B8G8R8A8SRGB,
-        R32G32B32A32SFloat
+        R32G32B32A32SFloat,
+        BC1RGBAUNorm,
+        BC1RGBASRGB,
+        BC3UNorm,
+        BC3SRGB,
+        BC4UNorm,
+        BC5UNorm,
+        BC7UNorm,
+        BC7SRGB,
+        R8UNorm,
+        R8G8UNorm,
+        R16SFloat,
+        R16G16B16A16SFloat,
+        B10G11R11UFloat,
+        /// <summary>
+        /// A 16-bit depth format without stencil, only usable as a depth attachment.
+        /// </summary>
+        D16UNorm = 0xFD,
+        /// <summary>
+        /// A 24-bit depth and 8-bit stencil format, only usable as a depth attachment.
+        /// </summary>
+        D24UNormS8UInt = 0xFE,
+        /// <summary>
+        /// A 32-bit float depth and 8-bit stencil format, only usable as a depth attachment.
+        /// </summary>
+        D32SFloatS8UInt = 0xFF
     }
 }
\ No newline at end of file
@@ -7,6 +7,11 @@ namespace DigBuild.Platform.Render
     /// </summary>
     public sealed class TextureSampler
     {
+        /// <summary>
+        /// A maximum LOD that does not clamp the mip levels that can be sampled.
+        /// </summary>
+        public const float NoLodClamp = 1000.0f;
+
         internal readonly NativeHandle Handle;
 
         internal TextureSampler(NativeHandle handle)
@@ -24,6 +29,15 @@ namespace DigBuild.Platform.Render
         Nearest
     }
 
+    /// <summary>
+    /// A method of selecting between mip levels.
+    /// </summary>
+    public enum TextureMipmapMode : byte
+    {
+        Linear,
+        Nearest
+    }
+
     /// <summary>
     /// A texture wrapping method.
     /// </summary>
@@ -56,6 +70,10 @@ namespace DigBuild.Platform.Render
         private readonly TextureBorderColor _borderColor;
         private readonly bool _enableAnisotropy;
         private readonly uint _anisotropyLevel;
+        private readonly TextureMipmapMode _mipmapMode;
+        private readonly float _minLod;
+        private readonly float _maxLod;
+        private readonly float _lodBias;
 
         internal TextureSamplerBuilder(
             RenderContext context,
@@ -64,7 +82,11 @@ namespace DigBuild.Platform.Render
             TextureWrapping wrapping,
             TextureBorderColor borderColor,
             bool enableAnisotropy = false,
-            uint anisotropyLevel = 0
+            uint anisotropyLevel = 0,
+            TextureMipmapMode mipmapMode = TextureMipmapMode.Nearest,
+            float minLod = 0,
+            float maxLod = TextureSampler.NoLodClamp,
+            float lodBias = 0
         )
         {
             _context = context;
@@ -74,6 +96,10 @@ namespace DigBuild.Platform.Render
             _borderColor = borderColor;
             _enableAnisotropy = enableAnisotropy;
             _anisotropyLevel = anisotropyLevel;
+            _mipmapMode = mipmapMode;
+            _minLod = minLod;
+            _maxLod = maxLod;
+            _lodBias = lodBias;
         }
 
         /// <summary>
@@ -86,7 +112,31 @@ namespace DigBuild.Platform.Render
             return new(
                 _context, _minFiltering, _maxFiltering,
                 _wrapping, _borderColor,
-                true, level
+                true, level,
+                _mipmapMode, _minLod, _maxLod, _lodBias
+            );
+        }
+
+        /// <summary>
+        /// Sets how mip levels are sampled.
+        /// </summary>
+        /// <param name="mode">The method of selecting between mip levels</param>
+        /// <param name="minLod">The lowest LOD that can be sampled</param>
+        /// <param name="maxLod">The highest LOD that can be sampled</param>
+        /// <param name="lodBias">The bias added to the computed LOD</param>
+        /// <returns>The builder</returns>
+        public TextureSamplerBuilder WithMipmaps(
+            TextureMipmapMode mode,
+            float minLod = 0,
+            float maxLod = TextureSampler.NoLodClamp,
+            float lodBias = 0
+        )
+        {
+            return new(
+                _context, _minFiltering, _maxFiltering,
+                _wrapping, _borderColor,
+                _enableAnisotropy, _anisotropyLevel,
+                mode, minLod, maxLod, lodBias
             );
         }
 
@@ -101,7 +151,11 @@ namespace DigBuild.Platform.Render
                         builder._wrapping,
                         builder._borderColor,
                         builder._enableAnisotropy,
-                        builder._anisotropyLevel
+                        builder._anisotropyLevel,
+                        builder._mipmapMode,
+                        builder._minLod,
+                        builder._maxLod,
+                        builder._lodBias
                     )
                 )
             );
@@ -9,6 +9,10 @@ namespace DigBuild.Platform.Render
     internal interface IUniformBufferBindings
     {
         void Write(IntPtr instance, IntPtr data, uint dataLength);
+        IntPtr Map(IntPtr instance, uint dataLength);
+        void Commit(IntPtr instance, uint dataLength);
+        void SetCapacityPolicy(IntPtr instance, in BufferCapacityPolicy policy);
+        void GetStats(IntPtr instance, out BufferStats stats);
     }
 
     internal static class UniformBuffer
@@ -41,6 +45,48 @@ namespace DigBuild.Platform.Render
                 (uint) (buffer.Count * Marshal.SizeOf<T>())
             );
         }
+
+        /// <summary>
+        /// Maps native memory for new data, which replaces the contents of the uniform buffer once committed.
+        /// The memory must not be accessed after calling <see cref="Commit"/>.
+        /// </summary>
+        /// <param name="count">The maximum number of elements</param>
+        /// <returns>The mapped elements</returns>
+        public unsafe Span<T> Map(uint count)
+        {
+            var ptr = UniformBuffer.Bindings.Map(Handle, (uint) (count * Marshal.SizeOf<T>()));
+            return new Span<T>(ptr.ToPointer(), (int) count);
+        }
+
+        /// <summary>
+        /// Commits the data written to the mapped memory.
+        /// </summary>
+        /// <param name="count">The number of elements written</param>
+        public void Commit(uint count)
+        {
+            UniformBuffer.Bindings.Commit(Handle, (uint) (count * Marshal.SizeOf<T>()));
+        }
+
+        /// <summary>
+        /// Sets how the capacity of the uniform buffer grows and shrinks with its contents.
+        /// </summary>
+        /// <param name="policy">The policy</param>
+        public void SetCapacityPolicy(BufferCapacityPolicy policy)
+        {
+            UniformBuffer.Bindings.SetCapacityPolicy(Handle, policy);
+        }
+
+        /// <summary>
+        /// The current memory usage of the uniform buffer.
+        /// </summary>
+        public BufferStats Stats
+        {
+            get
+            {
+                UniformBuffer.Bindings.GetStats(Handle, out var stats);
+                return stats;
+            }
+        }
     }
 
     /// <summary>
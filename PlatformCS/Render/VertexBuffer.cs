@@ -9,6 +9,11 @@ namespace DigBuild.Platform.Render
     internal interface IVertexBufferBindings
     {
         void Write(IntPtr instance, IntPtr data, uint dataLength);
+        void WriteRange(IntPtr instance, uint offset, IntPtr data, uint dataLength);
+        IntPtr Map(IntPtr instance, uint vertexCount);
+        void Commit(IntPtr instance, uint vertexCount);
+        void SetCapacityPolicy(IntPtr instance, in BufferCapacityPolicy policy);
+        void GetStats(IntPtr instance, out BufferStats stats);
     }
 
     internal static class VertexBuffer
@@ -28,6 +33,18 @@ namespace DigBuild.Platform.Render
         {
             Handle = handle;
         }
+
+        /// <summary>
+        /// The current memory usage of the vertex buffer.
+        /// </summary>
+        public BufferStats Stats
+        {
+            get
+            {
+                VertexBuffer.Bindings.GetStats(Handle, out var stats);
+                return stats;
+            }
+        }
     }
 
     /// <summary>
@@ -50,6 +67,51 @@ namespace DigBuild.Platform.Render
                 buffer.Count
             );
         }
+
+        /// <summary>
+        /// Overwrites part of the vertex buffer, leaving the rest of its contents untouched.
+        /// </summary>
+        /// <param name="offset">The index of the first vertex to overwrite</param>
+        /// <param name="buffer">The data</param>
+        public void WriteRange(uint offset, INativeBuffer<TVertex> buffer)
+        {
+            VertexBuffer.Bindings.WriteRange(
+                Handle,
+                offset,
+                buffer.Ptr,
+                buffer.Count
+            );
+        }
+
+        /// <summary>
+        /// Maps native memory for new vertices, which replace the contents of the vertex buffer once committed.
+        /// The memory must not be accessed after calling <see cref="Commit"/>.
+        /// </summary>
+        /// <param name="vertexCount">The maximum number of vertices</param>
+        /// <returns>The mapped vertices</returns>
+        public unsafe Span<TVertex> Map(uint vertexCount)
+        {
+            var ptr = VertexBuffer.Bindings.Map(Handle, vertexCount);
+            return new Span<TVertex>(ptr.ToPointer(), (int) vertexCount);
+        }
+
+        /// <summary>
+        /// Commits the vertices written to the mapped memory.
+        /// </summary>
+        /// <param name="vertexCount">The number of vertices written</param>
+        public void Commit(uint vertexCount)
+        {
+            VertexBuffer.Bindings.Commit(Handle, vertexCount);
+        }
+
+        /// <summary>
+        /// Sets how the capacity of the vertex buffer grows and shrinks with its contents.
+        /// </summary>
+        /// <param name="policy">The policy</param>
+        public void SetCapacityPolicy(BufferCapacityPolicy policy)
+        {
+            VertexBuffer.Bindings.SetCapacityPolicy(Handle, policy);
+        }
     }
 
     /// <summary>
@@ -91,4 +153,35 @@ namespace DigBuild.Platform.Render
             return new VertexBuffer<TVertex>(handle);
         }
     }
+
+    [StructLayout(LayoutKind.Sequential)]
+    internal readonly struct TransientVertexRange
+    {
+        private readonly uint _chunk;
+        private readonly uint _offset;
+        private readonly uint _size;
+        private readonly uint _vertexSize;
+        private readonly ulong _frame;
+    }
+
+    /// <summary>
+    /// Vertices allocated for a single frame. They are only valid until the next update, and can only be drawn
+    /// by command buffers committed before it.
+    /// </summary>
+    /// <typeparam name="TVertex">The vertex type</typeparam>
+    public readonly struct TransientVertices<TVertex> where TVertex : unmanaged
+    {
+        internal readonly TransientVertexRange Range;
+
+        /// <summary>
+        /// The number of vertices.
+        /// </summary>
+        public readonly uint VertexCount;
+
+        internal TransientVertices(TransientVertexRange range, uint vertexCount)
+        {
+            Range = range;
+            VertexCount = vertexCount;
+        }
+    }
 }
\ No newline at end of file
@@ -14,7 +14,11 @@ namespace DigBuild.Platform.Util
         Long, ULong,
         Float, Double,
         Float2, Float3, Float4,
-        Float4x4
+        Float4x4,
+        Half2, Half4,
+        SNorm8x4, UNorm8x4,
+        UNorm16x2,
+        A2B10G10R10
     }
 
     /// <summary>
@@ -64,6 +68,18 @@ namespace DigBuild.Platform.Util
                 return NumericType.Float4;
             if (type == typeof(Matrix4x4))
                 return NumericType.Float4x4;
+            if (type == typeof(Half2))
+                return NumericType.Half2;
+            if (type == typeof(Half4))
+                return NumericType.Half4;
+            if (type == typeof(SNorm8x4))
+                return NumericType.SNorm8x4;
+            if (type == typeof(UNorm8x4))
+                return NumericType.UNorm8x4;
+            if (type == typeof(UNorm16x2))
+                return NumericType.UNorm16x2;
+            if (type == typeof(A2B10G10R10))
+                return NumericType.A2B10G10R10;
             throw new ArgumentException($"The type must be a numeric type. Got: {type.Name}", nameof(type));
         }
     }
@@ -0,0 +1,139 @@
+﻿using System;
+using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace DigBuild.Platform.Util
+{
+    /// <summary>
+    /// Two half-precision floats, read by shaders as a vec2.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct Half2
+    {
+        public readonly Half X, Y;
+
+        public Half2(float x, float y)
+        {
+            X = (Half) x;
+            Y = (Half) y;
+        }
+
+        public Half2(Vector2 vector) : this(vector.X, vector.Y)
+        {
+        }
+    }
+
+    /// <summary>
+    /// Four half-precision floats, read by shaders as a vec4.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct Half4
+    {
+        public readonly Half X, Y, Z, W;
+
+        public Half4(float x, float y, float z, float w)
+        {
+            X = (Half) x;
+            Y = (Half) y;
+            Z = (Half) z;
+            W = (Half) w;
+        }
+
+        public Half4(Vector4 vector) : this(vector.X, vector.Y, vector.Z, vector.W)
+        {
+        }
+    }
+
+    /// <summary>
+    /// Four signed bytes, read by shaders as a vec4 in the [-1, 1] range. Suited for normals and tangents.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct SNorm8x4
+    {
+        public readonly sbyte X, Y, Z, W;
+
+        public SNorm8x4(float x, float y, float z, float w)
+        {
+            X = Pack(x);
+            Y = Pack(y);
+            Z = Pack(z);
+            W = Pack(w);
+        }
+
+        public SNorm8x4(Vector4 vector) : this(vector.X, vector.Y, vector.Z, vector.W)
+        {
+        }
+
+        private static sbyte Pack(float value) => (sbyte) MathF.Round(Math.Clamp(value, -1, 1) * sbyte.MaxValue);
+    }
+
+    /// <summary>
+    /// Four unsigned bytes, read by shaders as a vec4 in the [0, 1] range. Suited for colors.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct UNorm8x4
+    {
+        public readonly byte X, Y, Z, W;
+
+        public UNorm8x4(float x, float y, float z, float w)
+        {
+            X = Pack(x);
+            Y = Pack(y);
+            Z = Pack(z);
+            W = Pack(w);
+        }
+
+        public UNorm8x4(Vector4 vector) : this(vector.X, vector.Y, vector.Z, vector.W)
+        {
+        }
+
+        private static byte Pack(float value) => (byte) MathF.Round(Math.Clamp(value, 0, 1) * byte.MaxValue);
+    }
+
+    /// <summary>
+    /// Two unsigned shorts, read by shaders as a vec2 in the [0, 1] range. Suited for texture coordinates.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct UNorm16x2
+    {
+        public readonly ushort X, Y;
+
+        public UNorm16x2(float x, float y)
+        {
+            X = Pack(x);
+            Y = Pack(y);
+        }
+
+        public UNorm16x2(Vector2 vector) : this(vector.X, vector.Y)
+        {
+        }
+
+        private static ushort Pack(float value) => (ushort) MathF.Round(Math.Clamp(value, 0, 1) * ushort.MaxValue);
+    }
+
+    /// <summary>
+    /// Three 10-bit and one 2-bit unsigned values packed into 32 bits, read by shaders as a vec4 in the [0, 1] range.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public readonly struct A2B10G10R10
+    {
+        private const uint Max10 = (1 << 10) - 1;
+        private const uint Max2 = (1 << 2) - 1;
+
+        public readonly uint Value;
+
+        public A2B10G10R10(float x, float y, float z, float w)
+        {
+            Value = Pack(x, Max10) |
+                    Pack(y, Max10) << 10 |
+                    Pack(z, Max10) << 20 |
+                    Pack(w, Max2) << 30;
+        }
+
+        public A2B10G10R10(Vector4 vector) : this(vector.X, vector.Y, vector.Z, vector.W)
+        {
+        }
+
+        private static uint Pack(float value, uint max) => (uint) MathF.Round(Math.Clamp(value, 0, 1) * max);
+    }
+}
\ No newline at end of file